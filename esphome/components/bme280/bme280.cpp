@@ -185,32 +185,36 @@ void BME280Component::update() {
   meas_time += 2.3f * oversampling_to_time(this->humidity_oversampling_) + 0.575f;
 
   this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
-    uint8_t data[8];
-    if (!this->read_bytes(BME280_REGISTER_MEASUREMENTS, data, 8)) {
-      ESP_LOGW(TAG, "Error reading registers.");
-      this->status_set_warning();
-      return;
-    }
-    int32_t t_fine = 0;
-    float temperature = this->read_temperature_(data, &t_fine);
-    if (std::isnan(temperature)) {
-      ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
-      this->status_set_warning();
-      return;
-    }
-    float pressure = this->read_pressure_(data, t_fine);
-    float humidity = this->read_humidity_(data, t_fine);
-
-    ESP_LOGV(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
-    if (this->temperature_sensor_ != nullptr)
-      this->temperature_sensor_->publish_state(temperature);
-    if (this->pressure_sensor_ != nullptr)
-      this->pressure_sensor_->publish_state(pressure);
-    if (this->humidity_sensor_ != nullptr)
-      this->humidity_sensor_->publish_state(humidity);
-    this->status_clear_warning();
+    this->read_register_async(BME280_REGISTER_MEASUREMENTS, this->measurements_, 8,
+                              [this](i2c::ErrorCode err) { this->publish_measurements_(err); });
   });
 }
+void BME280Component::publish_measurements_(i2c::ErrorCode err) {
+  const uint8_t *data = this->measurements_;
+  if (err != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "Error reading registers.");
+    this->status_set_warning();
+    return;
+  }
+  int32_t t_fine = 0;
+  float temperature = this->read_temperature_(data, &t_fine);
+  if (std::isnan(temperature)) {
+    ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
+    this->status_set_warning();
+    return;
+  }
+  float pressure = this->read_pressure_(data, t_fine);
+  float humidity = this->read_humidity_(data, t_fine);
+
+  ESP_LOGV(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
+  if (this->temperature_sensor_ != nullptr)
+    this->temperature_sensor_->publish_state(temperature);
+  if (this->pressure_sensor_ != nullptr)
+    this->pressure_sensor_->publish_state(pressure);
+  if (this->humidity_sensor_ != nullptr)
+    this->humidity_sensor_->publish_state(humidity);
+  this->status_clear_warning();
+}
 float BME280Component::read_temperature_(const uint8_t *data, int32_t *t_fine) {
   int32_t adc = ((data[3] & 0xFF) << 16) | ((data[4] & 0xFF) << 8) | (data[5] & 0xFF);
   adc >>= 4;
@@ -81,6 +81,8 @@ class BME280Component : public PollingComponent, public i2c::I2CDevice {
   void update() override;
 
  protected:
+  /// Calculate and publish the values from the measurement registers once they were read.
+  void publish_measurements_(i2c::ErrorCode err);
   /// Read the temperature value and store the calculated ambient temperature in t_fine.
   float read_temperature_(const uint8_t *data, int32_t *t_fine);
   /// Read the pressure value in hPa using the provided t_fine value.
@@ -96,6 +98,8 @@ class BME280Component : public PollingComponent, public i2c::I2CDevice {
   BME280Oversampling pressure_oversampling_{BME280_OVERSAMPLING_16X};
   BME280Oversampling humidity_oversampling_{BME280_OVERSAMPLING_16X};
   BME280IIRFilter iir_filter_{BME280_IIR_FILTER_OFF};
+  /// Measurement registers, filled by the bus while update() doesn't block.
+  uint8_t measurements_[8];
   sensor::Sensor *temperature_sensor_;
   sensor::Sensor *pressure_sensor_;
   sensor::Sensor *humidity_sensor_;
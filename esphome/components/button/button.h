@@ -34,7 +34,9 @@ class Button : public EntityBase {
    *
    * @param callback The void() callback.
    */
-  void add_on_press_callback(std::function<void()> &&callback);
+  template<typename F> void add_on_press_callback(F &&callback) {
+    this->press_callback_.add(std::forward<F>(callback));
+  }
 
   /// Set the Home Assistant device class (see button::device_class).
   void set_device_class(const std::string &device_class);
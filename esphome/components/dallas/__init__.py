@@ -1,25 +1,94 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import pins
-from esphome.const import CONF_ID, CONF_PIN
+from esphome.const import CONF_ID, CONF_MEMORY_BLOCKS, CONF_PIN, CONF_PLATFORM
+from esphome.core import CORE
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32, VARIANT_ESP32S2
 
 MULTI_CONF = True
 AUTO_LOAD = ["sensor"]
 
+CONF_RMT_CHANNEL = "rmt_channel"
+
 dallas_ns = cg.esphome_ns.namespace("dallas")
 DallasComponent = dallas_ns.class_("DallasComponent", cg.PollingComponent)
 
+# The bus uses the transmit channel and the next channel with two memory blocks for receiving
+RMT_MEMORY_BLOCKS = 3
+# RMT channels of the variants where every channel can send and receive
+RMT_CHANNELS = {VARIANT_ESP32: 8, VARIANT_ESP32S2: 4}
+
+
+def validate_rmt_channel(value):
+    if not CORE.is_esp32:
+        raise cv.Invalid("rmt_channel is only available on ESP32")
+    variant = get_esp32_variant()
+    if variant not in RMT_CHANNELS:
+        raise cv.Invalid(f"The 1-Wire bus can't use the RMT peripheral on {variant}")
+    value = cv.int_(value)
+    max_channel = RMT_CHANNELS[variant] - RMT_MEMORY_BLOCKS
+    if not 0 <= value <= max_channel:
+        raise cv.Invalid(
+            f"rmt_channel must be between 0 and {max_channel}, "
+            f"the bus uses {RMT_MEMORY_BLOCKS} memory blocks"
+        )
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(DallasComponent),
         cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
+        cv.Optional(CONF_RMT_CHANNEL): validate_rmt_channel,
     }
 ).extend(cv.polling_component_schema("60s"))
 
 
+def rmt_memory_blocks(full_config):
+    """Return the RMT memory blocks taken by other components, as (first block, count, user) tuples."""
+    used = []
+    # remote_transmitter and remote_receiver take channels from the bottom in the order they are set up
+    remote_block = 0
+    for domain in ("remote_transmitter", "remote_receiver"):
+        for conf in full_config.get(domain, []):
+            count = conf.get(CONF_MEMORY_BLOCKS, 1)
+            used.append((remote_block, count, domain))
+            remote_block += count
+    for conf in full_config.get("light", []):
+        if conf[CONF_PLATFORM] == "esp32_rmt_led_strip":
+            used.append((conf[CONF_RMT_CHANNEL], 1, "esp32_rmt_led_strip"))
+    for conf in full_config.get("dallas", []):
+        if CONF_RMT_CHANNEL in conf:
+            used.append((conf[CONF_RMT_CHANNEL], RMT_MEMORY_BLOCKS, f"dallas {conf[CONF_ID]}"))
+    return used
+
+
+def final_validate_rmt_channel(config):
+    if CONF_RMT_CHANNEL not in config:
+        return config
+    first = config[CONF_RMT_CHANNEL]
+    for other_first, count, user in rmt_memory_blocks(fv.full_config.get()):
+        if user == f"dallas {config[CONF_ID]}":
+            continue
+        if first < other_first + count and other_first < first + RMT_MEMORY_BLOCKS:
+            raise cv.Invalid(
+                f"RMT channels {first} to {first + RMT_MEMORY_BLOCKS - 1} overlap with the "
+                f"RMT memory blocks {other_first} to {other_first + count - 1} used by {user}",
+                path=[CONF_RMT_CHANNEL],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_rmt_channel
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    if CONF_RMT_CHANNEL in config:
+        cg.add(var.set_rmt_channel(config[CONF_RMT_CHANNEL]))
@@ -32,7 +32,19 @@ void DallasComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DallasComponent...");
 
   pin_->setup();
-  one_wire_ = new ESPOneWire(pin_);  // NOLINT(cppcoreguidelines-owning-memory)
+#ifdef HAS_RMT_ONE_WIRE
+  if (this->rmt_channel_.has_value()) {
+    auto *rmt_one_wire = new RMTOneWire(pin_, *this->rmt_channel_);  // NOLINT(cppcoreguidelines-owning-memory)
+    if (rmt_one_wire->setup()) {
+      one_wire_ = rmt_one_wire;
+      this->rmt_ = true;
+    } else {
+      delete rmt_one_wire;  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+  }
+#endif
+  if (one_wire_ == nullptr)
+    one_wire_ = new ESPOneWire(pin_);  // NOLINT(cppcoreguidelines-owning-memory)
 
   std::vector<uint64_t> raw_sensors;
   raw_sensors = this->one_wire_->search_vec();
@@ -69,6 +81,7 @@ void DallasComponent::setup() {
 void DallasComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DallasComponent:");
   LOG_PIN("  Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Using RMT: %s", YESNO(this->rmt_));
   LOG_UPDATE_INTERVAL(this);
 
   if (this->found_sensors_.empty()) {
@@ -113,28 +126,37 @@ void DallasComponent::update() {
     return;
   }
 
-  for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion(), [this, sensor] {
-      bool res = sensor->read_scratch_pad();
-
-      if (!res) {
-        ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
-      if (!sensor->check_scratch_pad()) {
-        ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
+  // All sensors convert at the same time, so they're read together once the slowest one is done
+  uint16_t wait = 0;
+  for (auto *sensor : this->sensors_)
+    wait = std::max(wait, sensor->millis_to_wait_for_conversion());
+  this->set_timeout("read", wait, [this] { this->read_sensors_(0); });
+}
+void DallasComponent::read_sensors_(size_t index) {
+  if (index >= this->sensors_.size())
+    return;
+  // Another loop iteration for every sensor, so the whole bus doesn't block the loop at once
+  this->defer("read", [this, index] { this->read_sensors_(index + 1); });
+
+  auto *sensor = this->sensors_[index];
+  bool res = sensor->read_scratch_pad();
 
-      float tempc = sensor->get_temp_c();
-      ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
-      sensor->publish_state(tempc);
-    });
+  if (!res) {
+    ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
+  }
+  if (!sensor->check_scratch_pad()) {
+    ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
   }
+
+  float tempc = sensor->get_temp_c();
+  ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
+  sensor->publish_state(tempc);
 }
 
 void DallasTemperatureSensor::set_address(uint64_t address) { this->address_ = address; }
@@ -156,12 +178,8 @@ bool IRAM_ATTR DallasTemperatureSensor::read_scratch_pad() {
     return false;
   }
 
-  wire->select(this->address_);
-  wire->write8(DALLAS_COMMAND_READ_SCRATCH_PAD);
-
-  for (unsigned char &i : this->scratch_pad_) {
-    i = wire->read8();
-  }
+  wire->select(this->address_, DALLAS_COMMAND_READ_SCRATCH_PAD);
+  wire->read_bytes(this->scratch_pad_, sizeof(this->scratch_pad_));
   return true;
 }
 bool DallasTemperatureSensor::setup_sensor() {
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esp_one_wire.h"
+#include "rmt_one_wire.h"
 
 namespace esphome {
 namespace dallas {
@@ -12,6 +13,9 @@ class DallasTemperatureSensor;
 class DallasComponent : public PollingComponent {
  public:
   void set_pin(InternalGPIOPin *pin) { pin_ = pin; }
+#ifdef HAS_RMT_ONE_WIRE
+  void set_rmt_channel(uint8_t rmt_channel) { this->rmt_channel_ = rmt_channel; }
+#endif
   void register_sensor(DallasTemperatureSensor *sensor);
 
   void setup() override;
@@ -23,8 +27,15 @@ class DallasComponent : public PollingComponent {
  protected:
   friend DallasTemperatureSensor;
 
+  /// Read and publish the sensor at \p index, then continue with the next one in the next loop iteration.
+  void read_sensors_(size_t index);
+
   InternalGPIOPin *pin_;
-  ESPOneWire *one_wire_;
+  ESPOneWire *one_wire_{nullptr};
+  bool rmt_{false};
+#ifdef HAS_RMT_ONE_WIRE
+  optional<uint8_t> rmt_channel_;
+#endif
   std::vector<DallasTemperatureSensor *> sensors_;
   std::vector<uint64_t> found_sensors_;
 };
@@ -84,35 +84,57 @@ bool HOT IRAM_ATTR ESPOneWire::read_bit() {
   return r;
 }
 
-void ESPOneWire::write8(uint8_t val) {
-  for (uint8_t i = 0; i < 8; i++) {
-    this->write_bit(bool((1u << i) & val));
+void ESPOneWire::write_bytes(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    for (uint8_t j = 0; j < 8; j++) {
+      this->write_bit(bool((1u << j) & data[i]));
+    }
   }
 }
 
-void ESPOneWire::write64(uint64_t val) {
-  for (uint8_t i = 0; i < 64; i++) {
-    this->write_bit(bool((1ULL << i) & val));
+void ESPOneWire::read_bytes(uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    uint8_t ret = 0;
+    for (uint8_t j = 0; j < 8; j++) {
+      ret |= (uint8_t(this->read_bit()) << j);
+    }
+    data[i] = ret;
   }
 }
 
+void ESPOneWire::write8(uint8_t val) { this->write_bytes(&val, 1); }
+
+void ESPOneWire::write64(uint64_t val) {
+  uint8_t data[8];
+  for (uint8_t i = 0; i < 8; i++)
+    data[i] = val >> (i * 8);
+  this->write_bytes(data, 8);
+}
+
 uint8_t ESPOneWire::read8() {
-  uint8_t ret = 0;
-  for (uint8_t i = 0; i < 8; i++) {
-    ret |= (uint8_t(this->read_bit()) << i);
-  }
+  uint8_t ret;
+  this->read_bytes(&ret, 1);
   return ret;
 }
 uint64_t ESPOneWire::read64() {
+  uint8_t data[8];
+  this->read_bytes(data, 8);
   uint64_t ret = 0;
-  for (uint8_t i = 0; i < 8; i++) {
-    ret |= (uint64_t(this->read_bit()) << i);
-  }
+  for (uint8_t i = 0; i < 8; i++)
+    ret |= uint64_t(data[i]) << (i * 8);
   return ret;
 }
-void ESPOneWire::select(uint64_t address) {
-  this->write8(ONE_WIRE_ROM_SELECT);
-  this->write64(address);
+void ESPOneWire::select(uint64_t address) { this->select_(address, nullptr); }
+void ESPOneWire::select(uint64_t address, uint8_t command) { this->select_(address, &command); }
+void ESPOneWire::select_(uint64_t address, const uint8_t *command) {
+  // One write, so hardware backends can send it in one go
+  uint8_t data[10];
+  data[0] = ONE_WIRE_ROM_SELECT;
+  for (uint8_t i = 0; i < 8; i++)
+    data[i + 1] = address >> (i * 8);
+  if (command != nullptr)
+    data[9] = *command;
+  this->write_bytes(data, command != nullptr ? 10 : 9);
 }
 void ESPOneWire::reset_search() {
   this->last_discrepancy_ = 0;
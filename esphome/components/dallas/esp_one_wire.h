@@ -9,9 +9,14 @@ namespace dallas {
 extern const uint8_t ONE_WIRE_ROM_SELECT;
 extern const int ONE_WIRE_ROM_SEARCH;
 
+/** 1-Wire bus master that bit-bangs the bus, with interrupts disabled during each time slot.
+ *
+ * The primitives are virtual, so backends with hardware support only have to replace those.
+ */
 class ESPOneWire {
  public:
   explicit ESPOneWire(InternalGPIOPin *pin);
+  virtual ~ESPOneWire() = default;
 
   /** Reset the bus, should be done before all write operations.
    *
@@ -19,13 +24,19 @@ class ESPOneWire {
    *
    * @return Whether the operation was successful.
    */
-  bool reset();
+  virtual bool reset();
 
   /// Write a single bit to the bus, takes about 70µs.
-  void write_bit(bool bit);
+  virtual void write_bit(bool bit);
 
   /// Read a single bit from the bus, takes about 70µs
-  bool read_bit();
+  virtual bool read_bit();
+
+  /// Write \p len bytes to the bus. LSB first.
+  virtual void write_bytes(const uint8_t *data, size_t len);
+
+  /// Read \p len bytes from the bus.
+  virtual void read_bytes(uint8_t *data, size_t len);
 
   /// Write a word to the bus. LSB first.
   void write8(uint8_t val);
@@ -45,6 +56,9 @@ class ESPOneWire {
   /// Select a specific address on the bus for the following command.
   void select(uint64_t address);
 
+  /// Select a specific address on the bus and send \p command to it.
+  void select(uint64_t address, uint8_t command);
+
   /// Reset the device search.
   void reset_search();
 
@@ -55,6 +69,9 @@ class ESPOneWire {
   std::vector<uint64_t> search_vec();
 
  protected:
+  /// Write the ROM select command for \p address, followed by \p command if that's not null.
+  void select_(uint64_t address, const uint8_t *command);
+
   /// Helper to get the internal 64-bit unsigned rom number as a 8-bit integer pointer.
   inline uint8_t *rom_number8_();
 
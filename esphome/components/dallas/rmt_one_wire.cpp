@@ -0,0 +1,213 @@
+#include "rmt_one_wire.h"
+
+#ifdef HAS_RMT_ONE_WIRE
+
+#include "esphome/core/log.h"
+#include <driver/gpio.h>
+#include <soc/gpio_periph.h>
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace dallas {
+
+static const char *const TAG = "dallas.rmt";
+
+// With the 80 MHz APB clock, one tick is 1µs. Timings follow the recommended values of
+// https://www.maximintegrated.com/en/design/technical-documents/app-notes/1/126.html
+static const uint8_t CLOCK_DIVIDER = 80;
+static const uint16_t RESET_LOW_US = 480;
+static const uint16_t RESET_RELEASE_US = 480;
+static const uint16_t WRITE_1_LOW_US = 6;
+static const uint16_t WRITE_1_HIGH_US = 64;
+static const uint16_t WRITE_0_LOW_US = 60;
+static const uint16_t WRITE_0_HIGH_US = 10;
+// A read slot starts like a 1 is written, a device sending a 0 holds the bus low for longer
+static const uint16_t READ_SAMPLE_US = 15;
+// The receive channel ends a transaction once the bus didn't change for this long, during a reset that's only after
+// the presence pulse
+static const uint16_t SLOT_IDLE_US = 100;
+static const uint16_t RESET_IDLE_US = RESET_LOW_US + 60;
+// Ignore glitches shorter than this many APB clock cycles
+static const uint8_t FILTER_TICKS = 30;
+// A scratch pad read is 72 slots, the receive channel has two memory blocks of 64 items
+static const size_t MAX_READ_BYTES = 15;
+static const uint8_t RX_MEM_BLOCKS = 2;
+static const size_t RX_BUFFER_SIZE = 1024;
+static const uint32_t RX_TIMEOUT_MS = 20;
+
+static rmt_item32_t make_item(uint16_t low_us, uint16_t high_us) {
+  rmt_item32_t item{};
+  item.level0 = 0;
+  item.duration0 = low_us;
+  item.level1 = 1;
+  item.duration1 = high_us;
+  return item;
+}
+
+RMTOneWire::RMTOneWire(InternalGPIOPin *pin, uint8_t channel)
+    : ESPOneWire(pin), pin_num_(pin->get_pin()), channel_(channel) {}
+
+RMTOneWire::~RMTOneWire() {
+  if (this->tx_channel_ != RMT_CHANNEL_MAX)
+    rmt_driver_uninstall(this->tx_channel_);
+  if (this->rx_channel_ != RMT_CHANNEL_MAX)
+    rmt_driver_uninstall(this->rx_channel_);
+}
+
+bool RMTOneWire::setup() {
+  // The receive channel also uses the memory block of the channel above it, the config validation checks that these
+  // three blocks are free.
+  if (this->channel_ + 1 + RX_MEM_BLOCKS > RMT_CHANNEL_MAX) {
+    ESP_LOGW(TAG, "RMT channel %u doesn't leave room for the receive channel", this->channel_);
+    return false;
+  }
+  this->tx_channel_ = rmt_channel_t(this->channel_);
+  this->rx_channel_ = rmt_channel_t(this->channel_ + 1);
+
+  // The receive channel is set up first, configuring its pin as input disconnects it from the transmit channel
+  rmt_config_t rx{};
+  rx.rmt_mode = RMT_MODE_RX;
+  rx.channel = this->rx_channel_;
+  rx.gpio_num = gpio_num_t(this->pin_num_);
+  rx.clk_div = CLOCK_DIVIDER;
+  rx.mem_block_num = RX_MEM_BLOCKS;
+  rx.rx_config.filter_en = true;
+  rx.rx_config.filter_ticks_thresh = FILTER_TICKS;
+  rx.rx_config.idle_threshold = SLOT_IDLE_US;
+  esp_err_t err = rmt_config(&rx);
+  if (err == ESP_OK)
+    err = rmt_driver_install(this->rx_channel_, RX_BUFFER_SIZE, 0);
+  if (err == ESP_OK)
+    err = rmt_get_ringbuf_handle(this->rx_channel_, &this->ringbuf_);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Setting up receive channel failed: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  rmt_config_t tx{};
+  tx.rmt_mode = RMT_MODE_TX;
+  tx.channel = this->tx_channel_;
+  tx.gpio_num = gpio_num_t(this->pin_num_);
+  tx.clk_div = CLOCK_DIVIDER;
+  tx.mem_block_num = 1;
+  tx.tx_config.loop_en = false;
+  tx.tx_config.carrier_en = false;
+  tx.tx_config.idle_level = RMT_IDLE_LEVEL_HIGH;
+  tx.tx_config.idle_output_en = true;
+  err = rmt_config(&tx);
+  if (err == ESP_OK)
+    err = rmt_driver_install(this->tx_channel_, 0, 0);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Setting up transmit channel failed: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  // The transmit channel made the pin an output, connect the input again and make it open drain so devices can pull
+  // the bus low. This doesn't touch the routing of the signals.
+  PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[this->pin_num_]);
+  GPIO.pin[this->pin_num_].pad_driver = 1;
+  gpio_pullup_en(gpio_num_t(this->pin_num_));
+  ESP_LOGD(TAG, "Using RMT channels %d and %d", this->tx_channel_, this->rx_channel_);
+  return true;
+}
+
+bool RMTOneWire::send_items_() {
+  esp_err_t err = rmt_write_items(this->tx_channel_, this->items_.data(), this->items_.size(), true);
+  if (err != ESP_OK) {
+    ESP_LOGVV(TAG, "rmt_write_items failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+
+rmt_item32_t *RMTOneWire::transceive_items_(size_t *count) {
+  // Drop anything left over from an earlier transaction
+  size_t size;
+  void *stale;
+  while ((stale = xRingbufferReceive(this->ringbuf_, &size, 0)) != nullptr)
+    vRingbufferReturnItem(this->ringbuf_, stale);
+
+  rmt_rx_start(this->rx_channel_, true);
+  rmt_item32_t *items = nullptr;
+  size = 0;
+  if (this->send_items_())
+    items = static_cast<rmt_item32_t *>(xRingbufferReceive(this->ringbuf_, &size, pdMS_TO_TICKS(RX_TIMEOUT_MS)));
+  rmt_rx_stop(this->rx_channel_);
+  *count = size / sizeof(rmt_item32_t);
+  return items;
+}
+
+void RMTOneWire::return_items_(rmt_item32_t *items) {
+  if (items != nullptr)
+    vRingbufferReturnItem(this->ringbuf_, items);
+}
+
+bool RMTOneWire::reset() {
+  this->items_.clear();
+  this->items_.push_back(make_item(RESET_LOW_US, RESET_RELEASE_US));
+  rmt_set_rx_idle_thresh(this->rx_channel_, RESET_IDLE_US);
+  size_t count;
+  rmt_item32_t *items = this->transceive_items_(&count);
+  rmt_set_rx_idle_thresh(this->rx_channel_, SLOT_IDLE_US);
+
+  // Our own reset pulse, then the presence pulse of the devices, if there are any
+  bool present = count >= 2 && items[0].level0 == 0 && items[0].duration0 >= RESET_LOW_US - 2 &&
+                 items[0].level1 == 1 && items[0].duration1 > 0 && items[1].level0 == 0 && items[1].duration0 > 0;
+  this->return_items_(items);
+  return present;
+}
+
+void RMTOneWire::write_bit(bool bit) {
+  uint8_t data = bit;
+  this->write_bits_(&data, 1);
+}
+
+bool RMTOneWire::read_bit() {
+  uint8_t data;
+  this->read_bits_(&data, 1);
+  return data & 1;
+}
+
+void RMTOneWire::write_bytes(const uint8_t *data, size_t len) { this->write_bits_(data, len * 8); }
+
+void RMTOneWire::read_bytes(uint8_t *data, size_t len) {
+  while (len > 0) {
+    size_t chunk = std::min(len, MAX_READ_BYTES);
+    this->read_bits_(data, chunk * 8);
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+void RMTOneWire::write_bits_(const uint8_t *data, size_t bits) {
+  this->items_.clear();
+  for (size_t i = 0; i < bits; i++) {
+    if ((data[i / 8] >> (i % 8)) & 1) {
+      this->items_.push_back(make_item(WRITE_1_LOW_US, WRITE_1_HIGH_US));
+    } else {
+      this->items_.push_back(make_item(WRITE_0_LOW_US, WRITE_0_HIGH_US));
+    }
+  }
+  this->send_items_();
+}
+
+void RMTOneWire::read_bits_(uint8_t *data, size_t bits) {
+  this->items_.assign(bits, make_item(WRITE_1_LOW_US, WRITE_1_HIGH_US));
+  size_t count;
+  rmt_item32_t *items = this->transceive_items_(&count);
+  if (count < bits)
+    ESP_LOGVV(TAG, "Received %u of %u read slots", count, bits);
+  // Missing slots read as 1, like a bus nobody pulls low
+  memset(data, 0xFF, (bits + 7) / 8);
+  for (size_t i = 0; i < bits && i < count; i++) {
+    if (items[i].level0 == 0 && items[i].duration0 > READ_SAMPLE_US)
+      data[i / 8] &= ~(1 << (i % 8));
+  }
+  this->return_items_(items);
+}
+
+}  // namespace dallas
+}  // namespace esphome
+
+#endif  // HAS_RMT_ONE_WIRE
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "esp_one_wire.h"
+
+// Only chips where every RMT channel can both send and receive
+#if defined(USE_ESP32_VARIANT_ESP32) || defined(USE_ESP32_VARIANT_ESP32S2)
+#define HAS_RMT_ONE_WIRE
+#endif
+
+#ifdef HAS_RMT_ONE_WIRE
+
+#include <driver/rmt.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+
+namespace esphome {
+namespace dallas {
+
+/** 1-Wire bus master using the RMT peripheral, so interrupts stay enabled.
+ *
+ * A transmit and a receive channel share the open drain pin. Writes are sent as one sequence of time slots, reads send
+ * read slots while the receive channel samples how long each of them is held low. A reset, a select with command or a
+ * scratch pad read is a single transaction for the hardware.
+ */
+class RMTOneWire : public ESPOneWire {
+ public:
+  /// Use \p channel for transmitting and the next channel with two memory blocks for receiving.
+  RMTOneWire(InternalGPIOPin *pin, uint8_t channel);
+  ~RMTOneWire() override;
+
+  /// Configure the channels, returns false if that failed and bit-banging should be used instead.
+  bool setup();
+
+  bool reset() override;
+  void write_bit(bool bit) override;
+  bool read_bit() override;
+  void write_bytes(const uint8_t *data, size_t len) override;
+  void read_bytes(uint8_t *data, size_t len) override;
+
+ protected:
+  /// Write the lowest \p bits bits of \p data, LSB first, in one transaction.
+  void write_bits_(const uint8_t *data, size_t bits);
+  /// Read \p bits bits into \p data, LSB first, in one transaction. They have to fit in the receive memory.
+  void read_bits_(uint8_t *data, size_t bits);
+  /// Send the slots in items_, returns false if that failed.
+  bool send_items_();
+  /// Send the slots in items_ while receiving, returns the received items or nullptr. Release with return_items_().
+  rmt_item32_t *transceive_items_(size_t *count);
+  void return_items_(rmt_item32_t *items);
+
+  uint8_t pin_num_;
+  uint8_t channel_;
+  rmt_channel_t tx_channel_{RMT_CHANNEL_MAX};
+  rmt_channel_t rx_channel_{RMT_CHANNEL_MAX};
+  RingbufHandle_t ringbuf_{nullptr};
+  std::vector<rmt_item32_t> items_;
+};
+
+}  // namespace dallas
+}  // namespace esphome
+
+#endif  // HAS_RMT_ONE_WIRE
@@ -46,6 +46,47 @@ DISPLAY_ROTATIONS = {
 }
 
 
+def rle_encode_bits(bits):
+    """Run-length encode a bitmap given as a list of booleans in row order.
+
+    Each byte holds the length of a run of unset pixels in the upper nibble,
+    followed by a run of set pixels in the lower nibble.
+    """
+    data = []
+    pos = 0
+    while pos < len(bits):
+        off = 0
+        while pos < len(bits) and not bits[pos] and off < 15:
+            off += 1
+            pos += 1
+        on = 0
+        while pos < len(bits) and bits[pos] and on < 15:
+            on += 1
+            pos += 1
+        data.append(off << 4 | on)
+    return data
+
+
+def rle_encode_pixels(pixels):
+    """Run-length encode grayscale or RGB24 pixels in row order.
+
+    The pixels are tuples of bytes. Each run is a length byte followed by the bytes
+    of the pixel.
+    """
+    data = []
+    pos = 0
+    while pos < len(pixels):
+        run = 1
+        while (
+            pos + run < len(pixels) and pixels[pos + run] == pixels[pos] and run < 255
+        ):
+            run += 1
+        data.append(run)
+        data += pixels[pos]
+        pos += run
+    return data
+
+
 def validate_rotation(value):
     value = cv.string(value)
     if value.endswith("°"):
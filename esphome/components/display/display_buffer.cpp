@@ -12,6 +12,76 @@ namespace display {
 
 static const char *const TAG = "display";
 
+/// Call f(x, y, length, on) for each run of a run-length encoded bitmap, in row order. Runs never span rows.
+template<typename F> static void decode_rle_bits(const uint8_t *data, int width, int height, F &&f) {
+  const int total = width * height;
+  int pos = 0;
+  auto emit = [&](int len, bool on) {
+    while (len > 0 && pos < total) {
+      const int x = pos % width;
+      const int run = std::min(len, width - x);
+      f(x, pos / width, run, on);
+      pos += run;
+      len -= run;
+    }
+  };
+  while (pos < total) {
+    const uint8_t byte = progmem_read_byte(data++);
+    emit(byte >> 4, false);
+    emit(byte & 0x0F, true);
+  }
+}
+/// Call f(x, y, length, color) for each run of a run-length encoded grayscale or RGB24 image, in row order.
+template<typename F> static void decode_rle_pixels(const uint8_t *data, int width, int height, bool rgb, F &&f) {
+  const int total = width * height;
+  int pos = 0;
+  while (pos < total) {
+    int len = progmem_read_byte(data++);
+    Color color;
+    if (rgb) {
+      color = Color(progmem_read_byte(data), progmem_read_byte(data + 1), progmem_read_byte(data + 2));
+      data += 3;
+    } else {
+      const uint8_t gray = progmem_read_byte(data++);
+      color = Color(gray | gray << 8 | gray << 16 | gray << 24);
+    }
+    while (len > 0 && pos < total) {
+      const int x = pos % width;
+      const int run = std::min(len, width - x);
+      f(x, pos / width, run, color);
+      pos += run;
+      len -= run;
+    }
+  }
+}
+/// Get a single pixel of a run-length encoded bitmap, index must be in range.
+static bool rle_get_bit(const uint8_t *data, uint32_t index) {
+  uint32_t pos = 0;
+  while (true) {
+    const uint8_t byte = progmem_read_byte(data++);
+    pos += byte >> 4;
+    if (index < pos)
+      return false;
+    pos += byte & 0x0F;
+    if (index < pos)
+      return true;
+  }
+}
+/// Get a single pixel of a run-length encoded grayscale or RGB24 image, index must be in range.
+static Color rle_get_pixel(const uint8_t *data, uint32_t index, bool rgb) {
+  uint32_t pos = 0;
+  while (true) {
+    pos += progmem_read_byte(data++);
+    if (index < pos)
+      break;
+    data += rgb ? 3 : 1;
+  }
+  if (rgb)
+    return Color(progmem_read_byte(data), progmem_read_byte(data + 1), progmem_read_byte(data + 2));
+  const uint8_t gray = progmem_read_byte(data);
+  return Color(gray | gray << 8 | gray << 16 | gray << 24);
+}
+
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(255, 255, 255, 255);
 
@@ -90,14 +160,52 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->draw_absolute_run_(x, y, width, color);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      this->draw_absolute_run_(this->get_width_internal() - x - width, this->get_height_internal() - y - 1, width,
+                               color);
+      break;
+    default:
+      // A column of the display memory
+      for (int i = x; i < x + width; i++)
+        this->draw_pixel_at(i, y, color);
+      break;
+  }
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_90_DEGREES:
+      this->draw_absolute_run_(this->get_width_internal() - y - height, x, height, color);
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      this->draw_absolute_run_(y, this->get_height_internal() - x - 1, height, color);
+      break;
+    default:
+      // A column of the display memory
+      for (int i = y; i < y + height; i++)
+        this->draw_pixel_at(x, i, color);
+      break;
+  }
+}
+void HOT DisplayBuffer::draw_absolute_run_(int x, int y, int width, Color color) {
+  if (y < 0 || y >= this->get_height_internal())
+    return;
+  if (x < 0) {
+    width += x;
+    x = 0;
+  }
+  width = std::min(width, this->get_width_internal() - x);
+  if (width <= 0)
+    return;
+  this->fill_run_internal(x, y, width, color);
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::fill_run_internal(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++)
+    this->draw_absolute_pixel_internal(i, y, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -106,7 +214,12 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
+  // Along the rows of the display memory, so each line is a single run
+  if (this->rotation_ == DISPLAY_ROTATION_90_DEGREES || this->rotation_ == DISPLAY_ROTATION_270_DEGREES) {
+    for (int i = x1; i < x1 + width; i++)
+      this->vertical_line(i, y1, height, color);
+    return;
+  }
   for (int i = y1; i < y1 + height; i++) {
     this->horizontal_line(x1, i, width, color);
   }
@@ -162,15 +275,32 @@ void DisplayBuffer::filled_circle(int center_x, int center_y, int radius, Color
 }
 
 void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align, const char *text) {
+  // Only other than left aligned text needs measuring. The glyphs matched while measuring are drawn, at least for
+  // the first PRINT_MAX_GLYPHS of them.
+  static const int PRINT_MAX_GLYPHS = 64;
+  int16_t glyphs[PRINT_MAX_GLYPHS];
+  uint8_t lengths[PRINT_MAX_GLYPHS];
+  int num_glyphs = 0;
   int x_start, y_start;
-  int width, height;
-  this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+  int width, x_offset, baseline, height;
+  if ((int(align) & 0x18) == int(TextAlign::LEFT)) {
+    font->measure("", &width, &x_offset, &baseline, &height);
+  } else {
+    num_glyphs = font->measure(text, &width, &x_offset, &baseline, &height, glyphs, lengths, PRINT_MAX_GLYPHS);
+  }
+  this->align_text_(x, y, width, baseline, height, align, &x_start, &y_start);
 
   int i = 0;
   int x_at = x_start;
-  while (text[i] != '\0') {
+  for (int n = 0; text[i] != '\0'; n++) {
     int match_length;
-    int glyph_n = font->match_next_glyph(text + i, &match_length);
+    int glyph_n;
+    if (n < num_glyphs) {
+      glyph_n = glyphs[n];
+      match_length = lengths[n];
+    } else {
+      glyph_n = font->match_next_glyph(text + i, &match_length);
+    }
     if (glyph_n < 0) {
       // Unknown char, skip
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
@@ -188,16 +318,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     }
 
     const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    glyph.draw(x_at, y_start, this, color);
 
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
@@ -212,6 +333,31 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+  if (image->is_rle()) {
+    const int width = image->get_width();
+    switch (image->get_type()) {
+      case IMAGE_TYPE_BINARY:
+        decode_rle_bits(image->data_start_, width, image->get_height(), [=](int img_x, int img_y, int len, bool on) {
+          this->horizontal_line(x + img_x, y + img_y, len, on ? color_on : color_off);
+        });
+        break;
+      case IMAGE_TYPE_TRANSPARENT_BINARY:
+        decode_rle_bits(image->data_start_, width, image->get_height(), [=](int img_x, int img_y, int len, bool on) {
+          if (on)
+            this->horizontal_line(x + img_x, y + img_y, len, color_on);
+        });
+        break;
+      case IMAGE_TYPE_GRAYSCALE:
+      case IMAGE_TYPE_RGB24:
+        decode_rle_pixels(image->data_start_, width, image->get_height(), image->get_type() == IMAGE_TYPE_RGB24,
+                          [=](int img_x, int img_y, int len, Color color) {
+                            this->horizontal_line(x + img_x, y + img_y, len, color);
+                          });
+        break;
+    }
+    return;
+  }
+
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY:
       for (int img_x = 0; img_x < image->get_width(); img_x++) {
@@ -262,16 +408,19 @@ void DisplayBuffer::get_text_bounds(int x, int y, const char *text, Font *font,
                                     int *width, int *height) {
   int x_offset, baseline;
   font->measure(text, width, &x_offset, &baseline, height);
-
+  this->align_text_(x, y, *width, baseline, *height, align, x1, y1);
+}
+void DisplayBuffer::align_text_(int x, int y, int width, int baseline, int height, TextAlign align, int *x1,
+                                int *y1) {
   auto x_align = TextAlign(int(align) & 0x18);
   auto y_align = TextAlign(int(align) & 0x07);
 
   switch (x_align) {
     case TextAlign::RIGHT:
-      *x1 = x - *width;
+      *x1 = x - width;
       break;
     case TextAlign::CENTER_HORIZONTAL:
-      *x1 = x - (*width) / 2;
+      *x1 = x - width / 2;
       break;
     case TextAlign::LEFT:
     default:
@@ -282,13 +431,13 @@ void DisplayBuffer::get_text_bounds(int x, int y, const char *text, Font *font,
 
   switch (y_align) {
     case TextAlign::BOTTOM:
-      *y1 = y - *height;
+      *y1 = y - height;
       break;
     case TextAlign::BASELINE:
       *y1 = y - baseline;
       break;
     case TextAlign::CENTER_VERTICAL:
-      *y1 = y - (*height) / 2;
+      *y1 = y - height / 2;
       break;
     case TextAlign::TOP:
     default:
@@ -390,10 +539,48 @@ bool Glyph::get_pixel(int x, int y) const {
   const int y_data = y - this->glyph_data_->offset_y;
   if (x_data < 0 || x_data >= this->glyph_data_->width || y_data < 0 || y_data >= this->glyph_data_->height)
     return false;
+  if (this->glyph_data_->rle)
+    return rle_get_bit(this->glyph_data_->data, x_data + y_data * this->glyph_data_->width);
   const uint32_t width_8 = ((this->glyph_data_->width + 7u) / 8u) * 8u;
   const uint32_t pos = x_data + y_data * width_8;
   return progmem_read_byte(this->glyph_data_->data + (pos / 8u)) & (0x80 >> (pos % 8u));
 }
+void Glyph::draw(int x, int y, DisplayBuffer *display, Color color) const {
+  const int width = this->glyph_data_->width;
+  const int height = this->glyph_data_->height;
+  x += this->glyph_data_->offset_x;
+  y += this->glyph_data_->offset_y;
+  if (this->glyph_data_->rle) {
+    decode_rle_bits(this->glyph_data_->data, width, height, [=](int glyph_x, int glyph_y, int len, bool on) {
+      if (on)
+        display->horizontal_line(x + glyph_x, y + glyph_y, len, color);
+    });
+    return;
+  }
+
+  // Find the runs of set bits in each row of the bitmap, skipping whole empty bytes
+  const uint8_t *data = this->glyph_data_->data;
+  for (int glyph_y = 0; glyph_y < height; glyph_y++) {
+    int run_start = -1;
+    for (int glyph_x = 0; glyph_x < width; glyph_x++) {
+      const uint8_t byte = progmem_read_byte(data + glyph_x / 8u);
+      if (byte == 0 && run_start < 0 && glyph_x % 8 == 0) {
+        glyph_x += 7;
+        continue;
+      }
+      const bool on = byte & (0x80 >> (glyph_x % 8u));
+      if (on && run_start < 0) {
+        run_start = glyph_x;
+      } else if (!on && run_start >= 0) {
+        display->horizontal_line(x + run_start, y + glyph_y, glyph_x - run_start, color);
+        run_start = -1;
+      }
+    }
+    if (run_start >= 0)
+      display->horizontal_line(x + run_start, y + glyph_y, width - run_start, color);
+    data += (width + 7u) / 8u;
+  }
+}
 const char *Glyph::get_char() const { return this->glyph_data_->a_char; }
 bool Glyph::compare_to(const char *str) const {
   // 1 -> this->char_
@@ -427,7 +614,53 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *width = this->glyph_data_->width;
   *height = this->glyph_data_->height;
 }
+/// Number of bytes of the UTF-8 character starting with this byte.
+static uint8_t utf8_length(uint8_t first) {
+  if ((first & 0xE0) == 0xC0)
+    return 2;
+  if ((first & 0xF0) == 0xE0)
+    return 3;
+  if ((first & 0xF8) == 0xF0)
+    return 4;
+  return 1;
+}
 int Font::match_next_glyph(const char *str, int *match_length) {
+  const uint8_t first = str[0];
+  if (first < 0x80) {
+    const uint8_t index = this->ascii_glyphs_[first];
+    if (index == ASCII_NO_GLYPH) {
+      *match_length = 0;
+      return -1;
+    }
+    if (index != ASCII_SEARCH) {
+      *match_length = 1;
+      return index;
+    }
+    return this->search_glyph_(str, match_length);
+  }
+  if (this->has_multi_char_glyphs_)
+    return this->search_glyph_(str, match_length);
+
+  // Multi-byte characters, look them up in the cache first
+  const uint8_t length = utf8_length(first);
+  uint32_t character = 0;
+  for (uint8_t i = 0; i < length; i++) {
+    if (str[i] == '\0')
+      return this->search_glyph_(str, match_length);
+    character = (character << 8) | uint8_t(str[i]);
+  }
+  for (auto &cached : this->glyph_cache_) {
+    if (cached.character == character) {
+      *match_length = cached.glyph < 0 ? 0 : length;
+      return cached.glyph;
+    }
+  }
+  int glyph = this->search_glyph_(str, match_length);
+  this->glyph_cache_[this->glyph_cache_next_] = {character, int16_t(glyph)};
+  this->glyph_cache_next_ = (this->glyph_cache_next_ + 1) % GLYPH_CACHE_SIZE;
+  return glyph;
+}
+int Font::search_glyph_(const char *str, int *match_length) {
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -444,6 +677,11 @@ int Font::match_next_glyph(const char *str, int *match_length) {
   return lo;
 }
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
+  this->measure(str, width, x_offset, baseline, height, nullptr, nullptr, 0);
+}
+int Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height, int16_t *glyphs,
+                  uint8_t *lengths, int max_glyphs) {
+  int num_glyphs = 0;
   *baseline = this->baseline_;
   *height = this->bottom_;
   int i = 0;
@@ -453,6 +691,11 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   while (str[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph(str + i, &match_length);
+    if (num_glyphs < max_glyphs) {
+      glyphs[num_glyphs] = glyph_n;
+      lengths[num_glyphs] = glyph_n < 0 ? 1 : match_length;
+      num_glyphs++;
+    }
     if (glyph_n < 0) {
       // Unknown char, skip
       if (!this->get_glyphs().empty())
@@ -474,16 +717,34 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   }
   *x_offset = min_x;
   *width = x - min_x;
+  return num_glyphs;
 }
 const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(const GlyphData *data, int data_nr, int baseline, int bottom) : baseline_(baseline), bottom_(bottom) {
-  for (int i = 0; i < data_nr; ++i)
+  memset(this->ascii_glyphs_, ASCII_NO_GLYPH, sizeof(this->ascii_glyphs_));
+  for (int i = 0; i < data_nr; ++i) {
     glyphs_.emplace_back(data + i);
+
+    const char *a_char = data[i].a_char;
+    const uint8_t first = a_char[0];
+    const bool single_char = strlen(a_char) == utf8_length(first);
+    this->has_multi_char_glyphs_ |= !single_char;
+    if (first >= 0x80)
+      continue;
+    // Characters that start more than one glyph need the search to find the longest match
+    if (single_char && this->ascii_glyphs_[first] == ASCII_NO_GLYPH && i < ASCII_SEARCH) {
+      this->ascii_glyphs_[first] = i;
+    } else {
+      this->ascii_glyphs_[first] = ASCII_SEARCH;
+    }
+  }
 }
 
 bool Image::get_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return false;
+  if (this->rle_)
+    return rle_get_bit(this->data_start_, x + y * this->width_);
   const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
   const uint32_t pos = x + y * width_8;
   return progmem_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
@@ -491,6 +752,8 @@ bool Image::get_pixel(int x, int y) const {
 Color Image::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
+  if (this->rle_)
+    return rle_get_pixel(this->data_start_, x + y * this->width_, true);
   const uint32_t pos = (x + y * this->width_) * 3;
   const uint32_t color32 = (progmem_read_byte(this->data_start_ + pos + 2) << 0) |
                            (progmem_read_byte(this->data_start_ + pos + 1) << 8) |
@@ -500,6 +763,8 @@ Color Image::get_color_pixel(int x, int y) const {
 Color Image::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
+  if (this->rle_)
+    return rle_get_pixel(this->data_start_, x + y * this->width_, false);
   const uint32_t pos = (x + y * this->width_);
   const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
   return Color(gray | gray << 8 | gray << 16 | gray << 24);
@@ -507,8 +772,8 @@ Color Image::get_grayscale_pixel(int x, int y) const {
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
-Image::Image(const uint8_t *data_start, int width, int height, ImageType type)
-    : width_(width), height_(height), type_(type), data_start_(data_start) {}
+Image::Image(const uint8_t *data_start, int width, int height, ImageType type, bool rle)
+    : width_(width), height_(height), type_(type), data_start_(data_start), rle_(rle) {}
 
 bool Animation::get_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
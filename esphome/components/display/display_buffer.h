@@ -362,8 +362,17 @@ class DisplayBuffer {
 
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
+  /// Get the upper left corner of text with the given dimensions, see get_text_bounds().
+  void align_text_(int x, int y, int width, int baseline, int height, TextAlign align, int *x1, int *y1);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  /** Set \p width pixels of a row of the display memory, starting at [x,y], to \p color.
+   *
+   * The run is always within the display. Override this if the buffer can be filled faster than pixel by pixel.
+   */
+  virtual void fill_run_internal(int x, int y, int width, Color color);
+  /// Clip a run in display memory coordinates and hand it to fill_run_internal().
+  void draw_absolute_run_(int x, int y, int width, Color color);
 
   void init_internal_(uint32_t buffer_length);
 
@@ -403,6 +412,8 @@ struct GlyphData {
   int offset_y;
   int width;
   int height;
+  /// Whether data is run-length encoded instead of a bitmap, see Glyph::draw().
+  bool rle;
 };
 
 class Glyph {
@@ -411,6 +422,9 @@ class Glyph {
 
   bool get_pixel(int x, int y) const;
 
+  /// Draw the set pixels of this glyph with its top left corner at x, y, in horizontal runs.
+  void draw(int x, int y, DisplayBuffer *display, Color color) const;
+
   const char *get_char() const;
 
   bool compare_to(const char *str) const;
@@ -439,30 +453,66 @@ class Font {
   int match_next_glyph(const char *str, int *match_length);
 
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height);
+  /** Measure the text, and keep the glyphs that were matched for drawing it.
+   *
+   * Stores the index of the first max_glyphs glyphs (or -1 for unknown characters) in glyphs, and the number of bytes
+   * of the text they cover in lengths. Returns the number of glyphs stored.
+   */
+  int measure(const char *str, int *width, int *x_offset, int *baseline, int *height, int16_t *glyphs,
+              uint8_t *lengths, int max_glyphs);
 
   const std::vector<Glyph> &get_glyphs() const;
 
  protected:
+  /// Entries of ascii_glyphs_ for characters without a glyph, or with glyphs that need a search.
+  static const uint8_t ASCII_NO_GLYPH = 0xFF;
+  static const uint8_t ASCII_SEARCH = 0xFE;
+  static const uint8_t GLYPH_CACHE_SIZE = 8;
+
+  /// Binary search for the glyph at the start of str.
+  int search_glyph_(const char *str, int *match_length);
+
   std::vector<Glyph> glyphs_;
   int baseline_;
   int bottom_;
+  /// Index of the glyph for each single byte character.
+  uint8_t ascii_glyphs_[128];
+  /// Whether there are glyphs of more than one character, these can't be cached.
+  bool has_multi_char_glyphs_{false};
+  /// Recently used glyphs of multi-byte UTF-8 characters.
+  struct CachedGlyph {
+    uint32_t character;
+    int16_t glyph;
+  } glyph_cache_[GLYPH_CACHE_SIZE]{};
+  uint8_t glyph_cache_next_{0};
 };
 
+/** An image stored in flash.
+ *
+ * Run-length encoded images consist of runs in row order. Binary images alternate between runs of unset and set
+ * pixels, with the lengths of a pair in the upper and lower nibble of a byte. Grayscale and RGB24 images consist of a
+ * run length byte followed by the value of the pixels. These are quick to draw in horizontal lines, but getting
+ * a single pixel has to decode the image up to that pixel.
+ */
 class Image {
  public:
-  Image(const uint8_t *data_start, int width, int height, ImageType type);
+  Image(const uint8_t *data_start, int width, int height, ImageType type, bool rle = false);
   virtual bool get_pixel(int x, int y) const;
   virtual Color get_color_pixel(int x, int y) const;
   virtual Color get_grayscale_pixel(int x, int y) const;
   int get_width() const;
   int get_height() const;
   ImageType get_type() const;
+  bool is_rle() const { return this->rle_; }
 
  protected:
+  friend DisplayBuffer;
+
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
+  bool rle_{false};
 };
 
 class Animation : public Image {
@@ -0,0 +1,263 @@
+#include "led_strip.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace esp32_rmt_led_strip {
+
+static const char *const TAG = "esp32_rmt_led_strip";
+
+static const uint8_t RMT_CLK_DIV = 2;
+// Length of an RMT tick with the 80 MHz APB clock
+static const uint32_t RMT_TICK_NS = 1000 * RMT_CLK_DIV / 80;
+static const uint8_t MAX_RMT_CHANNELS = 8;
+static const uint32_t STATS_INTERVAL = 60000;
+
+// The translator gets no context, so each channel has its own translator with its own items for a 0 and a 1 bit
+static rmt_item32_t bit_items[MAX_RMT_CHANNELS][2];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template<uint8_t CHANNEL>
+static void IRAM_ATTR translate(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                                size_t *translated_size, size_t *item_num) {
+  const rmt_item32_t bit0 = bit_items[CHANNEL][0];
+  const rmt_item32_t bit1 = bit_items[CHANNEL][1];
+  const uint8_t *data = static_cast<const uint8_t *>(src);
+  size_t size = 0;
+  size_t num = 0;
+  while (size < src_size && num + 8 <= wanted_num) {
+    uint8_t byte = data[size++];
+    for (uint8_t mask = 0x80; mask != 0; mask >>= 1)
+      dest[num++] = (byte & mask) ? bit1 : bit0;
+  }
+  *translated_size = size;
+  *item_num = num;
+}
+
+static const sample_to_rmt_t TRANSLATORS[MAX_RMT_CHANNELS] = {
+    translate<0>, translate<1>, translate<2>, translate<3>,
+    translate<4>, translate<5>, translate<6>, translate<7>,
+};
+
+static rmt_item32_t make_bit_item(uint32_t high_ns, uint32_t low_ns) {
+  rmt_item32_t item{};
+  item.level0 = 1;
+  item.duration0 = high_ns / RMT_TICK_NS;
+  item.level1 = 0;
+  item.duration1 = low_ns / RMT_TICK_NS;
+  return item;
+}
+
+void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high,
+                                                 uint32_t bit1_low, uint32_t reset_time_us) {
+  this->bit0_high_ = bit0_high;
+  this->bit0_low_ = bit0_low;
+  this->bit1_high_ = bit1_high;
+  this->bit1_low_ = bit1_low;
+  this->reset_time_us_ = reset_time_us;
+}
+
+void ESP32RMTLEDStripLightOutput::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ESP32 RMT LED strip...");
+  if (this->channel_ >= RMT_CHANNEL_MAX) {
+    ESP_LOGE(TAG, "RMT channel %u is not available on this chip", this->channel_);
+    this->mark_failed();
+    return;
+  }
+
+  // The pixels the effects draw into, followed by the back, ready and front buffers
+  size_t buffer_size = this->get_buffer_size_();
+  this->buf_ = new uint8_t[4 * buffer_size];  // NOLINT
+  memset(this->buf_, 0, 4 * buffer_size);
+  this->back_ = this->buf_ + buffer_size;
+  this->ready_ = this->back_ + buffer_size;
+  this->front_ = this->ready_ + buffer_size;
+  this->effect_data_ = new uint8_t[this->num_leds_];  // NOLINT
+
+  bit_items[this->channel_][0] = make_bit_item(this->bit0_high_, this->bit0_low_);
+  bit_items[this->channel_][1] = make_bit_item(this->bit1_high_, this->bit1_low_);
+
+  auto channel = rmt_channel_t(this->channel_);
+  rmt_config_t config{};
+  config.rmt_mode = RMT_MODE_TX;
+  config.channel = channel;
+  config.gpio_num = gpio_num_t(this->pin_);
+  config.clk_div = RMT_CLK_DIV;
+  config.mem_block_num = 1;
+  config.tx_config.loop_en = false;
+  config.tx_config.carrier_en = false;
+  config.tx_config.idle_output_en = true;
+  config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+  esp_err_t error = rmt_config(&config);
+  if (error == ESP_OK)
+    error = rmt_driver_install(channel, 0, 0);
+  if (error == ESP_OK)
+    error = rmt_translator_init(channel, TRANSLATORS[this->channel_]);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring RMT driver failed: %s", esp_err_to_name(error));
+    this->mark_failed();
+    return;
+  }
+
+  uint32_t bit_time_ns = std::max(this->bit0_high_ + this->bit0_low_, this->bit1_high_ + this->bit1_low_);
+  // In 64 bits, sending a long strip takes more than 2^32 ns
+  this->frame_time_us_ = static_cast<uint64_t>(buffer_size) * 8 * bit_time_ns / 1000 + this->reset_time_us_;
+
+  esp_timer_create_args_t timer_args{};
+  timer_args.callback = &ESP32RMTLEDStripLightOutput::frame_timer;
+  timer_args.arg = this;
+  timer_args.dispatch_method = ESP_TIMER_TASK;
+  timer_args.name = "led_strip";
+  error = esp_timer_create(&timer_args, &this->timer_);
+  if (error == ESP_OK)
+    error = esp_timer_start_periodic(this->timer_, static_cast<uint64_t>(1e6f / this->frame_rate_));
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Starting the frame timer failed: %s", esp_err_to_name(error));
+    this->mark_failed();
+    return;
+  }
+
+  this->set_interval("stats", STATS_INTERVAL, [this]() {
+    if (this->frames_rendered_ == this->last_frames_rendered_)
+      return;
+    this->last_frames_rendered_ = this->frames_rendered_;
+    ESP_LOGD(TAG, "Frames rendered: %u, shown: %u, dropped: %u", this->frames_rendered_, this->frames_shown_,
+             this->frames_dropped_);
+  });
+}
+
+void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
+  if (this->is_failed())
+    return;
+
+  this->mark_shown_();
+  // The effects keep drawing into the pixels, so the timer sends a copy
+  memcpy(this->back_, this->buf_, this->get_buffer_size_());
+  portENTER_CRITICAL(&this->lock_);
+  std::swap(this->back_, this->ready_);
+  bool dropped = this->frame_ready_;
+  this->frame_ready_ = true;
+  portEXIT_CRITICAL(&this->lock_);
+
+  this->frames_rendered_++;
+  if (dropped)
+    this->frames_dropped_++;
+}
+
+void ESP32RMTLEDStripLightOutput::frame_timer(void *arg) {
+  static_cast<ESP32RMTLEDStripLightOutput *>(arg)->show_frame_();
+}
+
+void ESP32RMTLEDStripLightOutput::show_frame_() {
+  int64_t now = esp_timer_get_time();
+  // The previous frame or the reset after it isn't done yet, the newest frame goes out on the next tick
+  auto channel = rmt_channel_t(this->channel_);
+  if (now < this->send_done_us_ || rmt_wait_tx_done(channel, 0) != ESP_OK)
+    return;
+
+  portENTER_CRITICAL(&this->lock_);
+  bool ready = this->frame_ready_;
+  if (ready) {
+    std::swap(this->ready_, this->front_);
+    this->frame_ready_ = false;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+  if (!ready)
+    return;
+
+  this->send_done_us_ = now + this->frame_time_us_;
+  rmt_write_sample(channel, this->front_, this->get_buffer_size_(), false);
+  this->frames_shown_++;
+}
+
+light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+  int32_t r = 0, g = 0, b = 0;
+  switch (this->rgb_order_) {
+    case ORDER_RGB:
+      r = 0;
+      g = 1;
+      b = 2;
+      break;
+    case ORDER_RBG:
+      r = 0;
+      g = 2;
+      b = 1;
+      break;
+    case ORDER_GRB:
+      r = 1;
+      g = 0;
+      b = 2;
+      break;
+    case ORDER_GBR:
+      r = 2;
+      g = 0;
+      b = 1;
+      break;
+    case ORDER_BGR:
+      r = 2;
+      g = 1;
+      b = 0;
+      break;
+    case ORDER_BRG:
+      r = 1;
+      g = 2;
+      b = 0;
+      break;
+  }
+  uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
+  uint8_t *base = this->buf_ + multiplier * index;
+  return {base + r,
+          base + g,
+          base + b,
+          this->is_rgbw_ ? base + 3 : nullptr,
+          this->effect_data_ + index,
+          &this->correction_};
+}
+
+void ESP32RMTLEDStripLightOutput::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 RMT LED Strip:");
+  ESP_LOGCONFIG(TAG, "  Pin: %u", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Channel: %u", this->channel_);
+  const char *rgb_order;
+  switch (this->rgb_order_) {
+    case ORDER_RGB:
+      rgb_order = "RGB";
+      break;
+    case ORDER_RBG:
+      rgb_order = "RBG";
+      break;
+    case ORDER_GRB:
+      rgb_order = "GRB";
+      break;
+    case ORDER_GBR:
+      rgb_order = "GBR";
+      break;
+    case ORDER_BGR:
+      rgb_order = "BGR";
+      break;
+    case ORDER_BRG:
+      rgb_order = "BRG";
+      break;
+    default:
+      rgb_order = "UNKNOWN";
+      break;
+  }
+  ESP_LOGCONFIG(TAG, "  RGB Order: %s", rgb_order);
+  ESP_LOGCONFIG(TAG, "  Number of LEDs: %u", this->num_leds_);
+  ESP_LOGCONFIG(TAG, "  Frame Rate: %.1f Hz", this->frame_rate_);
+  if (this->frame_time_us_ > 1e6f / this->frame_rate_) {
+    ESP_LOGW(TAG, "  Sending a frame takes %u us, longer than the frame interval", this->frame_time_us_);
+  }
+}
+
+float ESP32RMTLEDStripLightOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+}  // namespace esp32_rmt_led_strip
+}  // namespace esphome
+
+#endif  // USE_ESP32
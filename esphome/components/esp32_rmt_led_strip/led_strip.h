@@ -0,0 +1,118 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/light_output.h"
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+#include <driver/rmt.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+namespace esphome {
+namespace esp32_rmt_led_strip {
+
+enum RGBOrder : uint8_t {
+  ORDER_RGB,
+  ORDER_RBG,
+  ORDER_GRB,
+  ORDER_GBR,
+  ORDER_BGR,
+  ORDER_BRG,
+};
+
+/** Addressable LED strip driven by an RMT channel, without blocking the main loop.
+ *
+ * Effects draw into the pixel buffer as usual. When a frame is complete it is copied to a back buffer, which is then
+ * swapped with the ready buffer. A timer running at the frame rate swaps the ready buffer with the front buffer and
+ * starts sending that, so frames go out at a steady rate whenever the main loop is busy. A frame that is replaced
+ * before it was sent is counted as dropped.
+ */
+class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
+ public:
+  void setup() override;
+  void write_state(light::LightState *state) override;
+  float get_setup_priority() const override;
+
+  int32_t size() const override { return this->num_leds_; }
+  light::LightTraits get_traits() override {
+    auto traits = light::LightTraits();
+    if (this->is_rgbw_) {
+      traits.set_supported_color_modes({light::ColorMode::RGB_WHITE});
+    } else {
+      traits.set_supported_color_modes({light::ColorMode::RGB});
+    }
+    return traits;
+  }
+
+  void set_pin(uint8_t pin) { this->pin_ = pin; }
+  void set_num_leds(uint16_t num_leds) { this->num_leds_ = num_leds; }
+  void set_is_rgbw(bool is_rgbw) { this->is_rgbw_ = is_rgbw; }
+  void set_rgb_order(RGBOrder rgb_order) { this->rgb_order_ = rgb_order; }
+  void set_rmt_channel(uint8_t channel) { this->channel_ = channel; }
+  void set_frame_rate(float frame_rate) { this->frame_rate_ = frame_rate; }
+  /// Set the bit timings in ns and the time the data line has to stay low after a frame in µs.
+  void set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high, uint32_t bit1_low,
+                      uint32_t reset_time_us);
+
+  void clear_effect_data() override {
+    for (int i = 0; i < this->size(); i++)
+      this->effect_data_[i] = 0;
+  }
+
+  void dump_config() override;
+
+  uint32_t get_frames_rendered() const { return this->frames_rendered_; }
+  uint32_t get_frames_shown() const { return this->frames_shown_; }
+  uint32_t get_frames_dropped() const { return this->frames_dropped_; }
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override;
+
+  size_t get_buffer_size_() const { return this->num_leds_ * (this->is_rgbw_ ? 4 : 3); }
+
+  /// Called by the timer at the frame rate.
+  static void frame_timer(void *arg);
+  /// Start sending the newest complete frame, if there is one and the previous frame is done.
+  void show_frame_();
+
+  uint8_t *buf_{nullptr};
+  uint8_t *effect_data_{nullptr};
+  // The back buffer belongs to the main loop, the front buffer to the timer, the ready buffer is swapped under lock_
+  uint8_t *back_{nullptr};
+  uint8_t *ready_{nullptr};
+  uint8_t *front_{nullptr};
+  bool frame_ready_{false};
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+
+  esp_timer_handle_t timer_{nullptr};
+  /// Time at which the frame being sent and the reset after it are done.
+  int64_t send_done_us_{0};
+  /// Time it takes to send one frame including the reset.
+  uint32_t frame_time_us_{0};
+
+  uint8_t pin_;
+  uint16_t num_leds_;
+  bool is_rgbw_{false};
+  RGBOrder rgb_order_{ORDER_GRB};
+  uint8_t channel_{0};
+  float frame_rate_{60.0f};
+  uint32_t bit0_high_;
+  uint32_t bit0_low_;
+  uint32_t bit1_high_;
+  uint32_t bit1_low_;
+  uint32_t reset_time_us_;
+
+  uint32_t frames_rendered_{0};
+  uint32_t frames_shown_{0};
+  uint32_t frames_dropped_{0};
+  uint32_t last_frames_rendered_{0};
+};
+
+}  // namespace esp32_rmt_led_strip
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,126 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome import pins
+from esphome.components import light
+from esphome.components.dallas import rmt_memory_blocks
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import (
+    VARIANT_ESP32,
+    VARIANT_ESP32C3,
+    VARIANT_ESP32H2,
+    VARIANT_ESP32S2,
+    VARIANT_ESP32S3,
+)
+from esphome.const import (
+    CONF_CHIPSET,
+    CONF_NUM_LEDS,
+    CONF_OUTPUT_ID,
+    CONF_PIN,
+    CONF_RGB_ORDER,
+)
+from esphome.core import CORE
+
+DEPENDENCIES = ["esp32"]
+
+esp32_rmt_led_strip_ns = cg.esphome_ns.namespace("esp32_rmt_led_strip")
+ESP32RMTLEDStripLightOutput = esp32_rmt_led_strip_ns.class_(
+    "ESP32RMTLEDStripLightOutput", light.AddressableLight
+)
+
+RGBOrder = esp32_rmt_led_strip_ns.enum("RGBOrder")
+RGB_ORDERS = {
+    "RGB": RGBOrder.ORDER_RGB,
+    "RBG": RGBOrder.ORDER_RBG,
+    "GRB": RGBOrder.ORDER_GRB,
+    "GBR": RGBOrder.ORDER_GBR,
+    "BGR": RGBOrder.ORDER_BGR,
+    "BRG": RGBOrder.ORDER_BRG,
+}
+
+# Bit timings in ns (0 high, 0 low, 1 high, 1 low) and reset time in µs
+CHIPSETS = {
+    "WS2812": (400, 850, 800, 450, 300),
+    "SK6812": (300, 900, 600, 600, 80),
+    "APA106": (350, 1360, 1360, 350, 50),
+    "WS2811": (250, 1000, 600, 650, 50),
+}
+
+CONF_FRAME_RATE = "frame_rate"
+CONF_IS_RGBW = "is_rgbw"
+CONF_RMT_CHANNEL = "rmt_channel"
+
+# RMT channels that can transmit, the first ones of each variant
+RMT_TX_CHANNELS = {
+    VARIANT_ESP32: 8,
+    VARIANT_ESP32S2: 4,
+    VARIANT_ESP32S3: 4,
+    VARIANT_ESP32C3: 2,
+    VARIANT_ESP32H2: 2,
+}
+
+
+def validate_rmt_channel(value):
+    if not CORE.is_esp32:
+        raise cv.Invalid("rmt_channel is only available on ESP32")
+    value = cv.int_(value)
+    max_channel = RMT_TX_CHANNELS[get_esp32_variant()] - 1
+    if not 0 <= value <= max_channel:
+        raise cv.Invalid(
+            f"rmt_channel must be between 0 and {max_channel} on this ESP32 variant"
+        )
+    return value
+
+CONFIG_SCHEMA = cv.All(
+    light.ADDRESSABLE_LIGHT_SCHEMA.extend(
+        {
+            cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(ESP32RMTLEDStripLightOutput),
+            cv.Required(CONF_PIN): pins.internal_gpio_output_pin_number,
+            cv.Required(CONF_NUM_LEDS): cv.positive_not_null_int,
+            cv.Required(CONF_RMT_CHANNEL): validate_rmt_channel,
+            cv.Optional(CONF_CHIPSET, default="WS2812"): cv.one_of(
+                *CHIPSETS, upper=True
+            ),
+            cv.Optional(CONF_RGB_ORDER, default="GRB"): cv.enum(RGB_ORDERS, upper=True),
+            cv.Optional(CONF_IS_RGBW, default=False): cv.boolean,
+            cv.Optional(CONF_FRAME_RATE, default="60Hz"): cv.All(
+                cv.frequency, cv.Range(min=1.0, max=1000.0)
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on_esp32,
+)
+
+
+def final_validate_rmt_channel(config):
+    channel = config[CONF_RMT_CHANNEL]
+    users = [
+        user
+        for first, count, user in rmt_memory_blocks(fv.full_config.get())
+        if first <= channel < first + count
+    ]
+    # The strip itself is one of them
+    users.remove("esp32_rmt_led_strip")
+    if users:
+        raise cv.Invalid(
+            f"RMT channel {channel} is also used by {users[0]}",
+            path=[CONF_RMT_CHANNEL],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_rmt_channel
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
+    await cg.register_component(var, config)
+    await light.register_light(var, config)
+
+    cg.add(var.set_pin(config[CONF_PIN]))
+    cg.add(var.set_num_leds(config[CONF_NUM_LEDS]))
+    cg.add(var.set_rmt_channel(config[CONF_RMT_CHANNEL]))
+    cg.add(var.set_rgb_order(config[CONF_RGB_ORDER]))
+    cg.add(var.set_is_rgbw(config[CONF_IS_RGBW]))
+    cg.add(var.set_frame_rate(config[CONF_FRAME_RATE]))
+    cg.add(var.set_led_params(*CHIPSETS[config[CONF_CHIPSET]]))
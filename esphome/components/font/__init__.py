@@ -109,13 +109,20 @@ async def to_code(config):
         width, height = mask.size
         width8 = ((width + 7) // 8) * 8
         glyph_data = [0] * (height * width8 // 8)
+        bits = []
         for y in range(height):
             for x in range(width):
-                if not mask.getpixel((x, y)):
+                bits.append(bool(mask.getpixel((x, y))))
+                if not bits[-1]:
                     continue
                 pos = x + y * width8
                 glyph_data[pos // 8] |= 0x80 >> (pos % 8)
-        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
+        # Large glyphs are mostly long runs, small ones are smaller as a bitmap
+        rle_data = display.rle_encode_bits(bits)
+        rle = len(rle_data) < len(glyph_data)
+        if rle:
+            glyph_data = rle_data
+        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height, rle)
         data += glyph_data
 
     rhs = [HexInt(x) for x in data]
@@ -135,6 +142,7 @@ async def to_code(config):
                 ("offset_y", glyph_args[glyph][2]),
                 ("width", glyph_args[glyph][3]),
                 ("height", glyph_args[glyph][4]),
+                ("rle", glyph_args[glyph][5]),
             )
         )
 
@@ -18,6 +18,8 @@ static const char *const TAGL = "graphlegend";
 void HistoryData::init(int length) {
   this->length_ = length;
   this->samples_.resize(length, NAN);
+  this->min_queue_.entries.resize(length);
+  this->max_queue_.entries.resize(length);
   this->last_sample_ = millis();
 }
 
@@ -30,32 +32,65 @@ void HistoryData::take_sample(float data) {
   this->period_ += dt;
   while (this->period_ >= this->update_time_) {
     this->samples_[this->count_] = data;
+    this->push_extremum_(this->min_queue_, this->sample_count_, this->count_, false);
+    this->push_extremum_(this->max_queue_, this->sample_count_, this->count_, true);
     this->period_ -= this->update_time_;
     this->count_ = (this->count_ + 1) % this->length_;
+    this->sample_count_++;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
   if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+    // Recent max/min include the current value, even if it hasn't been stored yet
+    float mn = this->get_extremum_(this->min_queue_);
+    float mx = this->get_extremum_(this->max_queue_);
+    this->recent_min_ = std::isnan(mn) ? data : std::min(mn, data);
+    this->recent_max_ = std::isnan(mx) ? data : std::max(mx, data);
   }
 }
 
+void HistoryData::push_extremum_(ExtremumQueue &queue, uint32_t seq, int pos, bool is_max) {
+  // Drop samples that have been overwritten in the ring buffer
+  while (queue.size > 0 && seq - queue.entries[queue.head].seq >= (uint32_t) this->length_) {
+    queue.head = (queue.head + 1) % this->length_;
+    queue.size--;
+  }
+  float value = this->samples_[pos];
+  if (std::isnan(value))
+    return;
+  // Drop samples that can't become the extremum anymore, as the new sample is at least as extreme and stays longer
+  while (queue.size > 0) {
+    float back = this->samples_[queue.entries[(queue.head + queue.size - 1) % this->length_].pos];
+    if (is_max ? back > value : back < value)
+      break;
+    queue.size--;
+  }
+  queue.entries[(queue.head + queue.size) % this->length_] = {seq, pos};
+  queue.size++;
+}
+
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
   this->data_.init(g->get_width());
+  this->plot_y_.resize(g->get_width());
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
 }
 
+void GraphTrace::update_plot_(float ymin, float yrange, uint32_t height, bool rescaled) {
+  uint32_t sample_count = this->data_.get_sample_count();
+  uint32_t added = sample_count - this->plot_sample_count_;
+  this->plot_sample_count_ = sample_count;
+
+  int n = this->data_.get_length();
+  if (!rescaled && added < (uint32_t) n)
+    n = added;
+  for (int i = 0; i < n; i++) {
+    float v = (this->data_.get_value(i) - ymin) / yrange;
+    int16_t y = std::isnan(v) ? PLOT_Y_NONE : (int16_t) roundf((height - 1) * (1.0 - v));
+    this->plot_y_[this->data_.get_ring_index(i)] = y;
+  }
+}
+
 void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
   /// Plot border
   if (this->border_) {
@@ -155,19 +190,23 @@ void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Colo
 
   /// Draw traces
   ESP_LOGV(TAG, "Updating graph. ymin %f, ymax %f", ymin, ymax);
+  // Only samples taken since the last draw need to be mapped onto the y-axis, unless the y-axis itself changed.
+  bool rescaled = ymin != this->plot_ymin_ || yrange != this->plot_yrange_;
+  this->plot_ymin_ = ymin;
+  this->plot_yrange_ = yrange;
   for (auto *trace : traces_) {
+    trace->update_plot_(ymin, yrange, this->height_, rescaled);
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    if (thick == 0)
+      continue;
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
+      int16_t y = trace->plot_y_[trace->data_.get_ring_index(i)];
+      if (y != PLOT_Y_NONE) {
         int16_t x = this->width_ - 1 - i;
         uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
         if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
-          for (uint16_t t = 0; t < thick; t++) {
-            buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
-          }
+          buff->vertical_line(x_offset + x, y_offset + y - thick / 2, thick, c);
         }
       }
     }
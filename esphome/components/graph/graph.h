@@ -18,6 +18,8 @@ namespace graph {
 class Graph;
 
 const Color COLOR_ON(255, 255, 255, 255);
+/// Marker in the cached trace plot for samples that aren't drawn
+const int16_t PLOT_Y_NONE = INT16_MIN;
 
 /// Bit pattern defines the line-type
 enum LineType {
@@ -89,19 +91,45 @@ class HistoryData {
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
+  float get_value(int idx) const { return samples_[this->get_ring_index(idx)]; }
+  /// Position in the ring buffer of the sample taken \p idx samples ago.
+  int get_ring_index(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  /// Total number of samples stored so far, used to find out which samples are new.
+  uint32_t get_sample_count() const { return sample_count_; }
   float get_recent_max() const { return recent_max_; }
   float get_recent_min() const { return recent_min_; }
 
  protected:
+  /** Monotonic queue over the ring buffer, used to keep track of the minimum or maximum incrementally.
+   *
+   * It holds the samples that can still become the extremum of the window, from most to least extreme (and thus from
+   * oldest to newest). Every sample is pushed and popped once, so updates take amortized constant time.
+   */
+  struct ExtremumQueue {
+    struct Entry {
+      uint32_t seq;  ///< Sample count at the time the sample was stored
+      int pos;       ///< Position of the sample in the ring buffer
+    };
+    std::vector<Entry> entries;
+    int head{0};
+    int size{0};
+  };
+  void push_extremum_(ExtremumQueue &queue, uint32_t seq, int pos, bool is_max);
+  float get_extremum_(const ExtremumQueue &queue) const {
+    return queue.size > 0 ? this->samples_[queue.entries[queue.head].pos] : NAN;
+  }
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
+  uint32_t sample_count_{0};
   float recent_min_{NAN};
   float recent_max_{NAN};
   std::vector<float> samples_;
+  ExtremumQueue min_queue_;
+  ExtremumQueue max_queue_;
 };
 
 class GraphTrace {
@@ -125,6 +153,13 @@ class GraphTrace {
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   HistoryData data_;
+  /// Rendered y position of every sample (relative to the top of the graph), in the same order as the samples.
+  std::vector<int16_t> plot_y_;
+  /// Sample count of the history data at the last time plot_y_ was updated.
+  uint32_t plot_sample_count_{0};
+
+  /// Update plot_y_ for the samples taken since the last call, or for all of them when the y-axis has changed.
+  void update_plot_(float ymin, float yrange, uint32_t height, bool rescaled);
 
   friend Graph;
   friend GraphLegend;
@@ -169,6 +204,9 @@ class Graph : public Component {
   float gridspacing_x_{NAN};
   float gridspacing_y_{NAN};
   bool border_{true};
+  /// y-axis of the last draw, the cached trace plots are only valid as long as it doesn't change
+  float plot_ymin_{NAN};
+  float plot_yrange_{NAN};
   std::vector<GraphTrace *> traces_;
   GraphLegend *legend_{nullptr};
 
@@ -110,3 +110,6 @@ async def register_i2c_device(var, config):
     parent = await cg.get_variable(config[CONF_I2C_ID])
     cg.add(var.set_i2c_bus(parent))
     cg.add(var.set_i2c_address(config[CONF_ADDRESS]))
+    if CONF_ID in config and config[CONF_ID].type.inherits_from(cg.PollingComponent):
+        # Keep the updates of the devices on one bus apart
+        cg.add(var.set_update_group(parent))
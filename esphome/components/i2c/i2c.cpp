@@ -1,4 +1,5 @@
 #include "i2c.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include <memory>
 
@@ -7,6 +8,18 @@ namespace i2c {
 
 static const char *const TAG = "i2c";
 
+void I2CBus::submit(Transaction &&transaction) {
+  ErrorCode err = this->run_write_(transaction);
+  if (err != ERROR_OK || transaction.delay_ms == 0 || transaction.read_len == 0) {
+    if (err == ERROR_OK)
+      err = this->run_read_(transaction);
+    transaction.callback(err);
+    return;
+  }
+  App.scheduler.set_timeout(nullptr, "", transaction.delay_ms,
+                            [this, transaction]() { transaction.callback(this->run_read_(transaction)); });
+}
+
 bool I2CDevice::write_bytes_16(uint8_t a_register, const uint16_t *data, uint8_t len) {
   // we have to copy in order to be able to change byte order
   std::unique_ptr<uint16_t[]> temp{new uint16_t[len]};
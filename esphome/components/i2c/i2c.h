@@ -4,6 +4,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/optional.h"
 #include <array>
+#include <cstring>
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -63,6 +65,32 @@ class I2CDevice {
     return bus_->writev(address_, buffers, 2);
   }
 
+  /** Write \p write_data, wait \p delay_ms and read \p read_len bytes into \p read_data, without blocking.
+   *
+   * \p callback is called from the main loop once the read is done or a phase failed. The write data is copied, at
+   * most TRANSACTION_MAX_WRITE bytes, but \p read_data must stay valid until the callback.
+   */
+  void write_then_read_async(const uint8_t *write_data, uint8_t write_len, uint32_t delay_ms, uint8_t *read_data,
+                             size_t read_len, std::function<void(ErrorCode)> &&callback) {
+    if (write_len > TRANSACTION_MAX_WRITE) {
+      callback(ERROR_TOO_LARGE);
+      return;
+    }
+    Transaction transaction;
+    transaction.address = this->address_;
+    memcpy(transaction.write_data, write_data, write_len);
+    transaction.write_len = write_len;
+    transaction.delay_ms = delay_ms;
+    transaction.read_data = read_data;
+    transaction.read_len = read_len;
+    transaction.callback = std::move(callback);
+    this->bus_->submit(std::move(transaction));
+  }
+  /// Read \p len bytes from \p a_register without blocking, see write_then_read_async().
+  void read_register_async(uint8_t a_register, uint8_t *data, size_t len, std::function<void(ErrorCode)> &&callback) {
+    this->write_then_read_async(&a_register, 1, 0, data, len, std::move(callback));
+  }
+
   // Compat APIs
 
   bool read_bytes(uint8_t a_register, uint8_t *data, uint8_t len) {
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,26 @@ struct WriteBuffer {
   size_t len;
 };
 
+/// Largest write an asynchronous transaction can hold, enough for a command with arguments.
+static const size_t TRANSACTION_MAX_WRITE = 8;
+
+/** A write to a device, followed by a read after an optional delay, run without blocking by I2CBus::submit().
+ *
+ * The bytes to write are copied into the transaction, the read buffer must stay valid until the callback is called.
+ * Either phase is skipped if its length is zero.
+ */
+struct Transaction {
+  uint8_t address;
+  uint8_t write_data[TRANSACTION_MAX_WRITE];
+  uint8_t write_len{0};
+  /// Time between the end of the write and the start of the read, e.g. to let a measurement finish.
+  uint32_t delay_ms{0};
+  uint8_t *read_data{nullptr};
+  size_t read_len{0};
+  /// Called from the main loop with ERROR_OK or the error of the phase that failed.
+  std::function<void(ErrorCode)> callback;
+};
+
 class I2CBus {
  public:
   virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) {
@@ -43,7 +64,26 @@ class I2CBus {
   }
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) = 0;
 
+  /** Queue \p transaction and return immediately, its callback is called once it's done.
+   *
+   * By default the write is done right away and the read is scheduled after the delay, so only the wait doesn't
+   * block. Buses that can transfer in the background override this.
+   */
+  virtual void submit(Transaction &&transaction);
+
  protected:
+  /// Run the write or the read phase of \p transaction now.
+  ErrorCode run_write_(const Transaction &transaction) {
+    if (transaction.write_len == 0)
+      return ERROR_OK;
+    return this->write(transaction.address, transaction.write_data, transaction.write_len);
+  }
+  ErrorCode run_read_(const Transaction &transaction) {
+    if (transaction.read_len == 0)
+      return ERROR_OK;
+    return this->read(transaction.address, transaction.read_data, transaction.read_len);
+  }
+
   void i2c_scan_() {
     for (uint8_t address = 8; address < 120; address++) {
       auto err = writev(address, nullptr, 0);
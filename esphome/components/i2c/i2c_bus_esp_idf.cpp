@@ -4,13 +4,21 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace esphome {
 namespace i2c {
 
 static const char *const TAG = "i2c.idf";
 
+static const uint8_t SUBMIT_QUEUE_SIZE = 16;
+// Room for a full submit queue and as many waiting reads, so the task rarely waits for the main loop
+static const uint8_t DONE_QUEUE_SIZE = 2 * SUBMIT_QUEUE_SIZE;
+// Enough for the verbose logging of the transfers
+static const uint32_t BUS_TASK_STACK_SIZE = 4096;
+
 void IDFI2CBus::setup() {
   static i2c_port_t next_port = 0;
   port_ = next_port++;
@@ -42,6 +50,25 @@ void IDFI2CBus::setup() {
     ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
     this->i2c_scan_();
   }
+
+  // The driver serializes transfers on a port, so the task can use it next to the blocking calls of the main loop
+  this->submit_queue_ = xQueueCreate(SUBMIT_QUEUE_SIZE, sizeof(PendingTransaction *));
+  this->done_queue_ = xQueueCreate(DONE_QUEUE_SIZE, sizeof(PendingTransaction *));
+  if (this->submit_queue_ == nullptr || this->done_queue_ == nullptr ||
+      xTaskCreate(&IDFI2CBus::bus_task, "i2c_bus", BUS_TASK_STACK_SIZE, this, uxTaskPriorityGet(nullptr),
+                  &this->task_) != pdPASS) {
+    ESP_LOGW(TAG, "Couldn't start the bus task, transactions will be run from the main loop");
+    this->task_ = nullptr;
+  }
+}
+void IDFI2CBus::loop() {
+  if (this->task_ == nullptr)
+    return;
+  PendingTransaction *pending;
+  while (xQueueReceive(this->done_queue_, &pending, 0) == pdTRUE) {
+    pending->transaction.callback(pending->error);
+    delete pending;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
 }
 void IDFI2CBus::dump_config() {
   ESP_LOGCONFIG(TAG, "I2C Bus:");
@@ -210,6 +237,59 @@ ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt) {
   return ERROR_OK;
 }
 
+void IDFI2CBus::submit(Transaction &&transaction) {
+  if (this->task_ == nullptr) {
+    I2CBus::submit(std::move(transaction));
+    return;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  auto *pending = new PendingTransaction{std::move(transaction), ERROR_OK, 0};
+  if (xQueueSend(this->submit_queue_, &pending, 0) != pdTRUE) {
+    ESP_LOGVV(TAG, "Transaction queue full, running transaction directly");
+    I2CBus::submit(std::move(pending->transaction));
+    delete pending;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+void IDFI2CBus::bus_task(void *params) {
+  auto *bus = reinterpret_cast<IDFI2CBus *>(params);
+  // Transactions waiting for their read phase, there are only ever a few
+  std::vector<PendingTransaction *> waiting;
+  waiting.reserve(SUBMIT_QUEUE_SIZE);
+  while (true) {
+    // Do the reads that are due and sleep until the next one, or until something is submitted
+    TickType_t wait = portMAX_DELAY;
+    uint32_t now = millis();
+    for (auto it = waiting.begin(); it != waiting.end();) {
+      PendingTransaction *pending = *it;
+      int32_t remaining = int32_t(pending->read_at - now);
+      if (remaining > 0) {
+        wait = std::min<TickType_t>(wait, pdMS_TO_TICKS(remaining) + 1);
+        ++it;
+        continue;
+      }
+      pending->error = bus->run_read_(pending->transaction);
+      xQueueSend(bus->done_queue_, &pending, portMAX_DELAY);
+      it = waiting.erase(it);
+    }
+
+    PendingTransaction *pending;
+    if (xQueueReceive(bus->submit_queue_, &pending, wait) != pdTRUE)
+      continue;
+    const Transaction &transaction = pending->transaction;
+    pending->error = bus->run_write_(transaction);
+    if (pending->error == ERROR_OK && transaction.read_len != 0) {
+      if (transaction.delay_ms != 0) {
+        pending->read_at = millis() + transaction.delay_ms;
+        waiting.push_back(pending);
+        continue;
+      }
+      pending->error = bus->run_read_(transaction);
+    }
+    xQueueSend(bus->done_queue_, &pending, portMAX_DELAY);
+  }
+}
+
 /// Perform I2C bus recovery, see:
 /// https://www.nxp.com/docs/en/user-guide/UM10204.pdf
 /// https://www.analog.com/media/en/technical-documentation/application-notes/54305147357414AN686_0.pdf
@@ -5,6 +5,9 @@
 #include "i2c_bus.h"
 #include "esphome/core/component.h"
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 
 namespace esphome {
 namespace i2c {
@@ -15,12 +18,19 @@ enum RecoveryCode {
   RECOVERY_COMPLETED,
 };
 
+/** I2C bus using the ESP-IDF driver.
+ *
+ * Submitted transactions are run by a separate task, which waits for the delays between their phases without holding
+ * up the bus. Their callbacks are called from loop().
+ */
 class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) override;
+  void submit(Transaction &&transaction) override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void set_scan(bool scan) { scan_ = scan; }
@@ -42,6 +52,19 @@ class IDFI2CBus : public I2CBus, public Component {
   bool scl_pullup_enabled_;
   uint32_t frequency_;
   bool initialized_ = false;
+
+  struct PendingTransaction {
+    Transaction transaction;
+    ErrorCode error;
+    /// millis() at which the read phase is due.
+    uint32_t read_at;
+  };
+
+  static void bus_task(void *params);
+
+  QueueHandle_t submit_queue_{nullptr};
+  QueueHandle_t done_queue_{nullptr};
+  TaskHandle_t task_{nullptr};
 };
 
 }  // namespace i2c
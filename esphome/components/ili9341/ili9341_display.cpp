@@ -4,6 +4,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace ili9341 {
 
@@ -92,13 +94,20 @@ void ILI9341Display::display_() {
   set_addr_window_(this->x_low_, this->y_low_, w, h);
   this->start_data_();
   uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
+  uint8_t index = 0;
   for (uint16_t row = 0; row < h; row++) {
     uint32_t pos = start_pos + (row * width_);
     uint32_t rem = w;
 
     while (rem > 0) {
-      uint32_t sz = buffer_to_transfer_(pos, rem);
-      this->write_array(transfer_buffer_, 2 * sz);
+      uint8_t *buffer = this->transfer_buffer_[index];
+      uint32_t sz = buffer_to_transfer_(buffer, pos, rem);
+      // Converting the next chunk overlaps with writing the previous one, which has to be done before its buffer
+      // is converted into again
+      this->wait_for_writes();
+      this->write_array_async(buffer, 2 * sz);
+      if (++index == ILI9341_TRANSFER_BUFFERS)
+        index = 0;
       pos += sz;
       rem -= sz;
     }
@@ -142,13 +151,14 @@ void ILI9341Display::fill(Color color) {
 }
 
 void ILI9341Display::fill_internal_(Color color) {
+  uint8_t *buffer = this->transfer_buffer_[0];
   if (color.raw_32 == Color::BLACK.raw_32) {
-    memset(transfer_buffer_, 0, sizeof(transfer_buffer_));
+    memset(buffer, 0, ILI9341_TRANSFER_BUFFER_SIZE);
   } else {
-    uint8_t *dst = transfer_buffer_;
+    uint8_t *dst = buffer;
     auto color565 = display::ColorUtil::color_to_565(color);
 
-    while (dst < transfer_buffer_ + sizeof(transfer_buffer_)) {
+    while (dst < buffer + ILI9341_TRANSFER_BUFFER_SIZE) {
       *dst++ = (uint8_t)(color565 >> 8);
       *dst++ = (uint8_t) color565;
     }
@@ -159,9 +169,10 @@ void ILI9341Display::fill_internal_(Color color) {
   this->set_addr_window_(0, 0, this->get_width_internal(), this->get_height_internal());
   this->start_data_();
 
+  // The buffer doesn't change, so all writes can be queued at once
   while (rem > 0) {
-    size_t sz = rem <= sizeof(transfer_buffer_) ? rem : sizeof(transfer_buffer_);
-    this->write_array(transfer_buffer_, sz);
+    size_t sz = rem <= ILI9341_TRANSFER_BUFFER_SIZE ? rem : ILI9341_TRANSFER_BUFFER_SIZE;
+    this->write_array_async(buffer, sz);
     rem -= sz;
   }
 
@@ -185,6 +196,16 @@ void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color)
   buffer_[pos] = convert_to_8bit_color_(color565);
 }
 
+void HOT ILI9341Display::fill_run_internal(int x, int y, int width, Color color) {
+  this->x_low_ = std::min<int>(x, this->x_low_);
+  this->y_low_ = std::min<int>(y, this->y_low_);
+  this->x_high_ = std::max<int>(x + width - 1, this->x_high_);
+  this->y_high_ = std::max<int>(y, this->y_high_);
+
+  auto color565 = display::ColorUtil::color_to_565(color);
+  memset(this->buffer_ + y * this->width_ + x, this->convert_to_8bit_color_(color565), width);
+}
+
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
 // values per bit is huge
 uint32_t ILI9341Display::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
@@ -238,12 +259,11 @@ void ILI9341Display::invert_display_(bool invert) { this->command(invert ? ILI93
 int ILI9341Display::get_width_internal() { return this->width_; }
 int ILI9341Display::get_height_internal() { return this->height_; }
 
-uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
+uint32_t ILI9341Display::buffer_to_transfer_(uint8_t *dst, uint32_t pos, uint32_t sz) {
   uint8_t *src = buffer_ + pos;
-  uint8_t *dst = transfer_buffer_;
 
-  if (sz > sizeof(transfer_buffer_) / 2) {
-    sz = sizeof(transfer_buffer_) / 2;
+  if (sz > ILI9341_TRANSFER_BUFFER_SIZE / 2) {
+    sz = ILI9341_TRANSFER_BUFFER_SIZE / 2;
   }
 
   for (uint32_t i = 0; i < sz; ++i) {
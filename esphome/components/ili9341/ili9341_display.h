@@ -9,6 +9,14 @@
 namespace esphome {
 namespace ili9341 {
 
+static const size_t ILI9341_TRANSFER_BUFFER_SIZE = 512;
+#ifdef USE_SPI_ESP_IDF_BACKEND
+// Writes run in the background, so one buffer is converted into while the other one is written
+static const uint8_t ILI9341_TRANSFER_BUFFERS = 2;
+#else
+static const uint8_t ILI9341_TRANSFER_BUFFERS = 1;
+#endif
+
 enum ILI9341Model {
   M5STACK = 0,
   TFT_24,
@@ -43,6 +51,7 @@ class ILI9341Display : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_run_internal(int x, int y, int width, Color color) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -71,9 +80,10 @@ class ILI9341Display : public PollingComponent,
   void start_data_();
   void end_data_();
 
-  uint8_t transfer_buffer_[64];
+  /// Buffers the display buffer is converted into for writing. Word aligned for DMA.
+  alignas(4) uint8_t transfer_buffer_[ILI9341_TRANSFER_BUFFERS][ILI9341_TRANSFER_BUFFER_SIZE];
 
-  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
+  uint32_t buffer_to_transfer_(uint8_t *dst, uint32_t pos, uint32_t sz);
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *led_pin_{nullptr};
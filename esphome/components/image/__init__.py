@@ -16,6 +16,8 @@ from esphome.core import CORE, HexInt
 
 _LOGGER = logging.getLogger(__name__)
 
+CONF_RLE = "rle"
+
 DEPENDENCIES = ["display"]
 MULTI_CONF = True
 
@@ -38,6 +40,7 @@ IMAGE_SCHEMA = cv.Schema(
         cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
             "NONE", "FLOYDSTEINBERG", upper=True
         ),
+        cv.Optional(CONF_RLE, default=False): cv.boolean,
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
     }
 )
@@ -67,7 +70,22 @@ async def to_code(config):
             )
 
     dither = Image.NONE if config[CONF_DITHER] == "NONE" else Image.FLOYDSTEINBERG
-    if config[CONF_TYPE] == "GRAYSCALE":
+    rle = config[CONF_RLE]
+    if rle:
+        if config[CONF_TYPE] == "GRAYSCALE":
+            image = image.convert("L", dither=dither)
+            data = display.rle_encode_pixels([(pix,) for pix in image.getdata()])
+        elif config[CONF_TYPE] == "RGB24":
+            image = image.convert("RGB")
+            data = display.rle_encode_pixels(list(image.getdata()))
+        elif config[CONF_TYPE] == "BINARY":
+            image = image.convert("1", dither=dither)
+            data = display.rle_encode_bits([not pix for pix in image.getdata()])
+        elif config[CONF_TYPE] == "TRANSPARENT_BINARY":
+            image = image.convert("RGBA")
+            data = display.rle_encode_bits([bool(pix[3]) for pix in image.getdata()])
+
+    elif config[CONF_TYPE] == "GRAYSCALE":
         image = image.convert("L", dither=dither)
         pixels = list(image.getdata())
         data = [0 for _ in range(height * width)]
@@ -114,5 +132,5 @@ async def to_code(config):
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     cg.new_Pvariable(
-        config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
+        config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]], rle
     )
@@ -0,0 +1,101 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+JsonWriter::JsonWriter(std::string &output) : output_(output) { this->output_.clear(); }
+
+void JsonWriter::begin_object() {
+  this->output_ += '{';
+  this->first_ = true;
+}
+void JsonWriter::end_object() { this->output_ += '}'; }
+
+void JsonWriter::add(const char *key, const char *value) {
+  this->write_key_(key);
+  this->output_ += '"';
+  this->write_escaped_(value, strlen(value));
+  this->output_ += '"';
+}
+void JsonWriter::add(const char *key, const std::string &value) {
+  this->write_key_(key);
+  this->output_ += '"';
+  this->write_escaped_(value.data(), value.size());
+  this->output_ += '"';
+}
+void JsonWriter::add(const char *key, const char *prefix, const std::string &value) {
+  this->write_key_(key);
+  this->output_ += '"';
+  this->write_escaped_(prefix, strlen(prefix));
+  this->write_escaped_(value.data(), value.size());
+  this->output_ += '"';
+}
+void JsonWriter::add(const char *key, bool value) {
+  this->write_key_(key);
+  this->output_ += value ? "true" : "false";
+}
+void JsonWriter::add(const char *key, int value) {
+  this->write_key_(key);
+  char buf[12];
+  snprintf(buf, sizeof(buf), "%d", value);
+  this->output_ += buf;
+}
+void JsonWriter::add(const char *key, float value) {
+  this->write_key_(key);
+  if (!std::isfinite(value)) {
+    this->output_ += "null";
+    return;
+  }
+  // 9 significant digits are enough to round-trip any float
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.9g", value);
+  this->output_ += buf;
+}
+
+void JsonWriter::write_key_(const char *key) {
+  if (!this->first_)
+    this->output_ += ',';
+  this->first_ = false;
+  this->output_ += '"';
+  this->write_escaped_(key, strlen(key));
+  this->output_ += "\":";
+}
+
+void JsonWriter::write_escaped_(const char *str, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    switch (c) {
+      case '"':
+        this->output_ += "\\\"";
+        break;
+      case '\\':
+        this->output_ += "\\\\";
+        break;
+      case '\n':
+        this->output_ += "\\n";
+        break;
+      case '\r':
+        this->output_ += "\\r";
+        break;
+      case '\t':
+        this->output_ += "\\t";
+        break;
+      default:
+        if (static_cast<uint8_t>(c) < 0x20) {
+          char buf[7];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          this->output_ += buf;
+        } else {
+          this->output_ += c;
+        }
+        break;
+    }
+  }
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace json {
+
+/** Lightweight streaming JSON writer for small, fixed-shape objects.
+ *
+ * Unlike build_json(), this doesn't build an ArduinoJson document first: members are serialized straight into the
+ * output string, so the only heap allocation is the output itself. Callers that write many objects in a row can
+ * reuse the same output string to avoid even that.
+ *
+ * Example usage:
+ *
+ * \code{.cpp}
+ * std::string out;
+ * json::JsonWriter writer(out);
+ * writer.begin_object();
+ * writer.add("id", "sensor-", obj->get_object_id());
+ * writer.add("value", obj->state);
+ * writer.end_object();
+ * \endcode
+ */
+class JsonWriter {
+ public:
+  /// Start writing to \p output. Existing content is cleared, but the capacity is kept.
+  explicit JsonWriter(std::string &output);
+
+  void begin_object();
+  void end_object();
+
+  /// Add a string member.
+  void add(const char *key, const char *value);
+  /// Add a string member.
+  void add(const char *key, const std::string &value);
+  /// Add a string member whose value is the concatenation of \p prefix and \p value, e.g. "sensor-" + object id.
+  void add(const char *key, const char *prefix, const std::string &value);
+  /// Add a boolean member.
+  void add(const char *key, bool value);
+  /// Add an integer member.
+  void add(const char *key, int value);
+  /// Add a number member, non-finite values are written as null (like ArduinoJson does).
+  void add(const char *key, float value);
+
+ protected:
+  void write_key_(const char *key);
+  void write_escaped_(const char *str, size_t len);
+
+  std::string &output_;
+  bool first_{true};
+};
+
+}  // namespace json
+}  // namespace esphome
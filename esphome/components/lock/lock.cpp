@@ -56,7 +56,6 @@ void Lock::publish_state(LockState state) {
   this->state_callback_.call();
 }
 
-void Lock::add_on_state_callback(std::function<void()> &&callback) { this->state_callback_.add(std::move(callback)); }
 uint32_t Lock::hash_base() { return 856245656UL; }
 
 void LockCall::perform() {
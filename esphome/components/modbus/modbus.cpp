@@ -11,6 +11,14 @@ void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+  // the largest RTU frame is 256 bytes, reserve it once so receiving never reallocates
+  this->rx_buffer_.reserve(256);
+  // An RTU character is 11 bits long: start bit, 8 data bits, parity or a second stop bit and the stop bit
+  uint32_t baud_rate = this->parent_->get_baud_rate();
+  this->char_time_us_ = baud_rate == 0 ? 0 : 11000000UL / baud_rate;
+  // The inter-frame delay is 3.5 characters, fixed to 1.75 ms above 19200 baud
+  this->frame_delay_us_ = baud_rate > 19200 ? 1750 : this->char_time_us_ * 7 / 2;
+  this->response_timeout_ = this->send_wait_time_;
 }
 void Modbus::loop() {
   const uint32_t now = millis();
@@ -19,20 +27,91 @@ void Modbus::loop() {
     this->rx_buffer_.clear();
     this->last_modbus_byte_ = now;
   }
-  // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
-  if (now - this->last_send_ > send_wait_time_) {
+  // stop blocking new send commands once the response timeout expired regardless if a response has been received
+  if (this->waiting_for_response != 0 && now - this->last_send_ > this->response_timeout_) {
+    ESP_LOGV(TAG, "No response from device 0x%02X within %u ms", this->waiting_for_response, this->response_timeout_);
+    // forget the learned latency, the next request gets the full send_wait_time_ again
+    auto *device = this->find_device_(this->waiting_for_response);
+    if (device != nullptr)
+      device->response_latency_us_ = 0;
     waiting_for_response = 0;
   }
 
   while (this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
+    this->last_bus_activity_us_ = micros();
     if (this->parse_modbus_byte_(byte)) {
       this->last_modbus_byte_ = now;
     } else {
       this->rx_buffer_.clear();
     }
   }
+
+  this->schedule_next_command_();
+}
+
+void Modbus::schedule_next_command_() {
+  // run the main loop without sleeping while a response is expected or a command is due, so the gap between frames
+  // isn't stretched to the loop interval
+  if (this->waiting_for_response != 0) {
+    this->high_freq_.start();
+    return;
+  }
+
+  const uint32_t now = millis();
+  const size_t count = this->devices_.size();
+  ModbusDevice *next = nullptr;
+  uint32_t next_deadline = 0;
+  size_t next_index = 0;
+  for (size_t i = 1; i <= count; i++) {
+    // start after the device that sent last, so devices with the same deadline take turns
+    size_t index = (this->last_device_index_ + i) % count;
+    uint32_t deadline;
+    if (!this->devices_[index]->get_next_deadline(deadline) || static_cast<int32_t>(deadline - now) > 0)
+      continue;
+    if (next == nullptr || static_cast<int32_t>(deadline - next_deadline) < 0) {
+      next = this->devices_[index];
+      next_deadline = deadline;
+      next_index = index;
+    }
+  }
+
+  if (next == nullptr) {
+    this->high_freq_.stop();
+    return;
+  }
+  this->high_freq_.start();
+
+  // don't send while a (foreign) frame is being received or before the inter-frame delay has passed
+  if (!this->rx_buffer_.empty() || micros() - this->last_bus_activity_us_ < this->frame_delay_us_)
+    return;
+
+  this->last_device_index_ = next_index;
+  next->send_next_command();
+}
+
+ModbusDevice *Modbus::find_device_(uint8_t address) {
+  for (auto *device : this->devices_) {
+    if (device->address_ == address)
+      return device;
+  }
+  return nullptr;
+}
+
+void Modbus::on_request_sent_(uint8_t address, uint16_t expected_response_bytes) {
+  this->waiting_for_response = address;
+  this->last_send_ = millis();
+  this->request_sent_us_ = micros();
+  this->last_bus_activity_us_ = this->request_sent_us_;
+  this->response_timeout_ = this->send_wait_time_;
+
+  auto *device = this->find_device_(address);
+  if (device == nullptr || device->response_latency_us_ == 0 || expected_response_bytes == 0)
+    return;
+  // twice the learned latency plus the time the response needs on the wire, with some slack for the main loop
+  uint32_t timeout_us = device->response_latency_us_ * 2 + expected_response_bytes * this->char_time_us_;
+  this->response_timeout_ = std::min<uint32_t>(this->send_wait_time_, timeout_us / 1000 + 20);
 }
 
 uint16_t crc16(const uint8_t *data, uint8_t len) {
@@ -57,8 +136,10 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
   const uint8_t *raw = &this->rx_buffer_[0];
   ESP_LOGV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
   // Byte 0: modbus address (match all)
-  if (at == 0)
+  if (at == 0) {
+    this->first_byte_us_ = micros();
     return true;
+  }
   uint8_t address = raw[0];
   uint8_t function_code = raw[1];
   // Byte 2: Size (with modbus rtu function code 4/3)
@@ -96,10 +177,19 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
     ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
     return false;
   }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
+      if (waiting_for_response == address) {
+        // Rise immediately and decay slowly: underestimating the latency causes timeouts, which cost much more than
+        // waiting a little longer than necessary
+        uint32_t latency = std::max<uint32_t>(this->first_byte_us_ - this->request_sent_us_, 1);
+        if (latency >= device->response_latency_us_) {
+          device->response_latency_us_ = latency;
+        } else {
+          device->response_latency_us_ = (device->response_latency_us_ * 7 + latency) / 8;
+        }
+      }
       // Is it an error response?
       if ((function_code & 0x80) == 0x80) {
         ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, raw[2]);
@@ -110,7 +200,7 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
           ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
         }
       } else {
-        device->on_modbus_data(data);
+        device->on_modbus_frame(raw + data_offset, data_len);
       }
       found = true;
     }
@@ -129,6 +219,7 @@ void Modbus::dump_config() {
   ESP_LOGCONFIG(TAG, "Modbus:");
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
+  ESP_LOGCONFIG(TAG, "  Frame Delay: %u us", this->frame_delay_us_);
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
@@ -179,8 +270,30 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
 
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = address;
-  last_send_ = millis();
+
+  uint16_t expected_response_bytes;
+  switch (function_code) {
+    case 0x1:
+    case 0x2:
+      // address, function code, byte count, packed bits, crc
+      expected_response_bytes = 5 + (number_of_entities + 7) / 8;
+      break;
+    case 0x3:
+    case 0x4:
+      expected_response_bytes = 5 + number_of_entities * 2;
+      break;
+    case 0x5:
+    case 0x6:
+    case 0xF:
+    case 0x10:
+      expected_response_bytes = 8;
+      break;
+    default:
+      // unknown response size, keep the full send_wait_time_
+      expected_response_bytes = 0;
+      break;
+  }
+  this->on_request_sent_(address, expected_response_bytes);
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
 }
 
@@ -201,9 +314,8 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   this->flush();
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = payload[0];
+  this->on_request_sent_(payload[0], 0);
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
-  last_send_ = millis();
 }
 
 }  // namespace modbus
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
 
 namespace esphome {
@@ -33,11 +34,33 @@ class Modbus : public uart::UARTDevice, public Component {
   GPIOPin *flow_control_pin_{nullptr};
 
   bool parse_modbus_byte_(uint8_t byte);
+  /// Let the device whose next command is due first send it, if the bus is idle.
+  void schedule_next_command_();
+  /// Find the registered device with the given address, or nullptr.
+  ModbusDevice *find_device_(uint8_t address);
+  /// Called after a request was written to the bus, arms the response timeout for the addressed device.
+  void on_request_sent_(uint8_t address, uint16_t expected_response_bytes);
+  /// Maximum time to wait for a response, also used until a device's response latency is known.
   uint16_t send_wait_time_{250};
+  /// Time to wait for the response to the request in flight, in ms.
+  uint32_t response_timeout_{250};
+  /// Time of one character on the bus in µs.
+  uint32_t char_time_us_{0};
+  /// Minimum silence between two frames (3.5 characters) in µs.
+  uint32_t frame_delay_us_{0};
+  /// Time the last byte was sent or received in µs.
+  uint32_t last_bus_activity_us_{0};
+  /// Time the request in flight was sent completely in µs.
+  uint32_t request_sent_us_{0};
+  /// Time the first byte of the frame in rx_buffer_ was received in µs.
+  uint32_t first_byte_us_{0};
   std::vector<uint8_t> rx_buffer_;
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
+  /// Index of the device that sent last, devices with the same deadline take turns.
+  size_t last_device_index_{0};
+  HighFrequencyLoopRequester high_freq_;
 };
 
 uint16_t crc16(const uint8_t *data, uint8_t len);
@@ -47,6 +70,14 @@ class ModbusDevice {
   void set_parent(Modbus *parent) { parent_ = parent; }
   void set_address(uint8_t address) { address_ = address; }
   virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
+  /** Called with the data of a received frame, pointing into the bus' receive buffer.
+   *
+   * The data is only valid during the call. The default implementation copies it into a vector for on_modbus_data(),
+   * devices that decode many frames can override this to avoid the allocation.
+   */
+  virtual void on_modbus_frame(const uint8_t *data, size_t len) {
+    this->on_modbus_data(std::vector<uint8_t>(data, data + len));
+  }
   virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
   void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
             const uint8_t *payload = nullptr) {
@@ -56,11 +87,27 @@ class ModbusDevice {
   // If more than one device is connected block sending a new command before a response is received
   bool waiting_for_response() { return parent_->waiting_for_response != 0; }
 
+  /** Report when this device next wants to use the bus.
+   *
+   * Devices that queue their commands implement this together with send_next_command(), so the bus can interleave
+   * the commands of all devices by deadline. Devices that send directly from update() don't need to.
+   *
+   * @param deadline Set to the millis() timestamp at which the next command is due.
+   * @return Whether a command is pending.
+   */
+  virtual bool get_next_deadline(uint32_t &deadline) { return false; }
+  /// Called by the bus when the bus is idle and this device's next command is the one due first.
+  virtual void send_next_command() {}
+
+  /// Get the learned time between the end of a request and the start of the response in µs, 0 if unknown.
+  uint32_t get_response_latency() const { return this->response_latency_us_; }
+
  protected:
   friend Modbus;
 
   Modbus *parent_;
   uint8_t address_;
+  uint32_t response_latency_us_{0};
 };
 
 }  // namespace modbus
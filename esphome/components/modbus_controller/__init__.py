@@ -10,6 +10,7 @@ from .const import (
     CONF_COMMAND_THROTTLE,
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_REGISTER_COUNT,
     CONF_REGISTER_TYPE,
@@ -31,6 +32,7 @@ ModbusController = modbus_controller_ns.class_(
 )
 
 SensorItem = modbus_controller_ns.struct("SensorItem")
+ModbusDataView = modbus_controller_ns.class_("ModbusDataView")
 
 ModbusFunctionCode_ns = modbus_controller_ns.namespace("ModbusFunctionCode")
 ModbusFunctionCode = ModbusFunctionCode_ns.enum("ModbusFunctionCode")
@@ -105,6 +107,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_COMMAND_THROTTLE, default="0ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(
+                min=0, max=125
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -197,7 +202,7 @@ async def add_modbus_base_properties(
                 (sensor_type.operator("ptr"), "item"),
                 (lamdba_param_type, "x"),
                 (
-                    cg.std_vector.template(cg.uint8).operator("const").operator("ref"),
+                    ModbusDataView.operator("const").operator("ref"),
                     "data",
                 ),
             ],
@@ -209,6 +214,7 @@ async def add_modbus_base_properties(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID], config[CONF_COMMAND_THROTTLE])
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
+    cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     await register_modbus_device(var, config)
 
 
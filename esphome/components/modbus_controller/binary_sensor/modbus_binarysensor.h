@@ -26,12 +26,12 @@ class ModbusBinarySensor : public Component, public binary_sensor::BinarySensor,
     }
   }
 
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(const ModbusDataView &data) override;
   void set_state(bool state) { this->state = state; }
 
   void dump_config() override;
 
-  using transform_func_t = std::function<optional<bool>(ModbusBinarySensor *, bool, const std::vector<uint8_t> &)>;
+  using transform_func_t = std::function<optional<bool>(ModbusBinarySensor *, bool, const ModbusDataView &)>;
   void set_template(transform_func_t &&f) { this->transform_func_ = f; }
 
  protected:
@@ -10,97 +10,109 @@ static const char *const TAG = "modbus_controller";
 void ModbusController::setup() {
   // Modbus::setup();
   this->create_register_ranges_();
+  this->coalesce_register_ranges_();
+  this->create_sensor_tables_();
+}
+
+bool ModbusController::get_next_deadline(uint32_t &deadline) {
+  if (command_queue_.empty())
+    return false;
+  // the oldest command is due right away, unless the command throttle holds it back
+  deadline = command_queue_.front().queued_at;
+  uint32_t throttle_end = this->last_command_timestamp_ + this->command_throttle_ + 1;
+  if (this->command_throttle_ > 0 && static_cast<int32_t>(throttle_end - deadline) > 0)
+    deadline = throttle_end;
+  return true;
 }
 
 /*
  To work with the existing modbus class and avoid polling for responses a command queue is used.
- send_next_command will submit the command at the top of the queue and set the corresponding callback
- to handle the response from the device.
+ The modbus bus calls send_next_command when it's idle and this device's oldest command is the one due first on the
+ bus. It submits the command at the top of the queue and sets the corresponding callback to handle the response
+ from the device.
  Once the response has been processed it is removed from the queue and the next command is sent
 */
-bool ModbusController::send_next_command_() {
-  uint32_t last_send = millis() - this->last_command_timestamp_;
-
-  if ((last_send > this->command_throttle_) && !waiting_for_response() && !command_queue_.empty()) {
+void ModbusController::send_next_command() {
+  if (!command_queue_.empty()) {
     auto &command = command_queue_.front();
 
     // remove from queue if command was sent too often
-    if (command->send_countdown < 1) {
+    if (command.send_countdown < 1) {
       ESP_LOGD(
           TAG,
           "Modbus command to device=%d register=0x%02X countdown=%d no response received - removed from send queue",
-          this->address_, command->register_address, command->send_countdown);
-      command_queue_.pop_front();
+          this->address_, command.register_address, command.send_countdown);
+      this->pop_command_();
     } else {
       ESP_LOGV(TAG, "Sending next modbus command to device %d register 0x%02X count %d", this->address_,
-               command->register_address, command->register_count);
-      command->send();
+               command.register_address, command.register_count);
+      command.send();
       this->last_command_timestamp_ = millis();
       // remove from queue if no handler is defined
-      if (!command->on_data_func) {
-        command_queue_.pop_front();
+      if (!command.on_data_func) {
+        this->pop_command_();
       }
     }
   }
-  return (!command_queue_.empty());
 }
 
-// Queue incoming response
 void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
-  auto &current_command = this->command_queue_.front();
-  if (current_command != nullptr) {
-    // Move the commandItem to the response queue
-    current_command->payload = data;
-    this->incoming_queue_.push(std::move(current_command));
-    ESP_LOGV(TAG, "Modbus response queued");
-    command_queue_.pop_front();
-  }
+  this->on_modbus_frame(data.data(), data.size());
 }
 
 // Dispatch the response to the registered handler
-void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
-  ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", response->register_address,
-           response->payload.size());
-  response->on_data_func(response->register_type, response->register_address, response->payload);
+void ModbusController::on_modbus_frame(const uint8_t *data, size_t len) {
+  if (command_queue_.empty())
+    return;
+  auto &current_command = this->command_queue_.front();
+  ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", current_command.register_address, len);
+  // The response is decoded in place, data is only valid during this call
+  const ModbusDataView response(data, len);
+  if (current_command.range != nullptr) {
+    this->publish_range_(*current_command.range, response);
+  } else if (current_command.on_data_func) {
+    current_command.on_data_func(current_command.register_type, current_command.register_address, response);
+  }
+  this->pop_command_();
 }
 
 void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
   ESP_LOGE(TAG, "Modbus error function code: 0x%X exception: %d ", function_code, exception_code);
   // Remove pending command waiting for a response
-  auto &current_command = this->command_queue_.front();
-  if (current_command != nullptr) {
+  if (!this->command_queue_.empty()) {
+    auto &current_command = this->command_queue_.front();
     ESP_LOGE(TAG,
              "Modbus error - last command: function code=0x%X  register adddress = 0x%X  "
              "registers count=%d "
              "payload size=%zu",
-             function_code, current_command->register_address, current_command->register_count,
-             current_command->payload.size());
-    command_queue_.pop_front();
+             function_code, current_command.register_address, current_command.register_count,
+             current_command.payload.size());
+    this->pop_command_();
   }
 }
 
-SensorSet ModbusController::find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const {
+void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address,
+                                        const ModbusDataView &data) {
+  ESP_LOGV(TAG, "data for register address : 0x%X : ", start_address);
+
   auto reg_it = find_if(begin(register_ranges_), end(register_ranges_), [=](RegisterRange const &r) {
     return (r.start_address == start_address && r.register_type == register_type);
   });
-
   if (reg_it == register_ranges_.end()) {
     ESP_LOGE(TAG, "No matching range for sensor found - start_address : 0x%X", start_address);
-  } else {
-    return reg_it->sensors;
+    return;
   }
-
-  // not found
-  return {};
+  this->publish_range_(*reg_it, data);
 }
-void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address,
-                                        const std::vector<uint8_t> &data) {
-  ESP_LOGV(TAG, "data for register address : 0x%X : ", start_address);
 
-  // loop through all sensors with the same start address
-  auto sensors = find_sensors_(register_type, start_address);
-  for (auto *sensor : sensors) {
-    sensor->parse_and_publish(data);
+void ModbusController::publish_range_(const RegisterRange &r, const ModbusDataView &data) {
+  for (const auto &entry : r.sensor_table) {
+    if (entry.data_end > data.size()) {
+      ESP_LOGW(TAG, "Response for range 0x%X too short for sensor at offset %u: %zu bytes", r.start_address,
+               entry.sensor->offset, data.size());
+      continue;
+    }
+    entry.sensor->parse_and_publish(data);
   }
 }
 
@@ -108,16 +120,27 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
   // check if this commmand is already qeued.
   // not very effective but the queue is never really large
   for (auto &item : command_queue_) {
-    if (item->register_address == command.register_address && item->register_count == command.register_count &&
-        item->register_type == command.register_type && item->function_code == command.function_code) {
+    if (item.register_address == command.register_address && item.register_count == command.register_count &&
+        item.register_type == command.register_type && item.function_code == command.function_code) {
       ESP_LOGW(TAG, "Duplicate modbus command found");
       // update the payload of the queued command
       // replaces a previous command
-      item->payload = command.payload;
+      item.payload = command.payload;
       return;
     }
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  if (this->command_pool_.empty()) {
+    command_queue_.push_back(command);
+  } else {
+    // reuse the node of a finished command, assigning keeps the capacity of its payload
+    command_queue_.splice(command_queue_.end(), this->command_pool_, this->command_pool_.begin());
+    command_queue_.back() = command;
+  }
+  command_queue_.back().queued_at = millis();
+}
+
+void ModbusController::pop_command_() {
+  this->command_pool_.splice(this->command_pool_.end(), command_queue_, command_queue_.begin());
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -126,21 +149,20 @@ void ModbusController::update_range_(RegisterRange &r) {
   if (r.skip_updates_counter == 0) {
     // if a custom command is used the user supplied custom_data is only available in the SensorItem.
     if (r.register_type == ModbusRegisterType::CUSTOM) {
-      auto sensors = this->find_sensors_(r.register_type, r.start_address);
-      if (!sensors.empty()) {
-        auto sensor = sensors.cbegin();
-        auto command_item = ModbusCommandItem::create_custom_command(
-            this, (*sensor)->custom_data,
-            [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
-              this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
-            });
+      if (!r.sensors.empty()) {
+        auto sensor = r.sensors.cbegin();
+        auto command_item = ModbusCommandItem::create_custom_command(this, (*sensor)->custom_data);
         command_item.register_address = (*sensor)->start_address;
         command_item.register_count = (*sensor)->register_count;
         command_item.function_code = ModbusFunctionCode::CUSTOM;
+        command_item.range = &r;
         queue_command(command_item);
       }
     } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+      auto command_item =
+          ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count);
+      command_item.range = &r;
+      queue_command(command_item);
     }
     r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
@@ -271,9 +293,111 @@ size_t ModbusController::create_register_ranges_() {
   return register_ranges_.size();
 }
 
+// A read round trip costs about 20 characters on the bus: 8 for the request, 5 for the address, function code, byte
+// count and crc of the response and two inter-frame delays of 3.5 characters. Reading unused registers to merge two
+// ranges pays off as long as they need fewer characters than that.
+static const uint16_t ROUND_TRIP_OVERHEAD_CHARS = 20;
+// Largest read the modbus component sends, see Modbus::send
+static const uint16_t MAX_RANGE_REGISTERS = 125;
+static const uint16_t MAX_RANGE_COILS = 128;
+
+bool ModbusController::can_coalesce_ranges_(const RegisterRange &range, const RegisterRange &next) const {
+  if (range.register_type != next.register_type || range.register_type == ModbusRegisterType::CUSTOM ||
+      range.skip_updates != next.skip_updates)
+    return false;
+  uint32_t range_end = range.start_address + range.register_count;
+  if (next.start_address < range_end)
+    return false;
+  uint32_t gap = next.start_address - range_end;
+  if (gap > this->max_register_gap_)
+    return false;
+
+  bool bits = range.register_type == ModbusRegisterType::COIL ||
+              range.register_type == ModbusRegisterType::DISCRETE_INPUT;
+  uint32_t gap_chars = bits ? (gap + 7) / 8 : gap * 2;
+  if (gap_chars >= ROUND_TRIP_OVERHEAD_CHARS)
+    return false;
+  uint32_t count = next.start_address + next.register_count - range.start_address;
+  if (count > (bits ? MAX_RANGE_COILS : MAX_RANGE_REGISTERS))
+    return false;
+
+  // Sensor offsets are moved by the distance between the start addresses, that only works for sensors using the
+  // standard response layout. force_new_range asks for a separate command explicitly.
+  for (auto *sensor : range.sensors) {
+    if (sensor->response_bytes != 0)
+      return false;
+  }
+  for (auto *sensor : next.sensors) {
+    if (sensor->response_bytes != 0 || sensor->force_new_range)
+      return false;
+  }
+  return true;
+}
+
+size_t ModbusController::coalesce_register_ranges_() {
+  if (this->max_register_gap_ == 0 || this->register_ranges_.size() < 2)
+    return this->register_ranges_.size();
+
+  std::vector<RegisterRange> ranges;
+  ranges.reserve(this->register_ranges_.size());
+  for (auto &r : this->register_ranges_) {
+    if (ranges.empty() || !this->can_coalesce_ranges_(ranges.back(), r)) {
+      ranges.push_back(r);
+      continue;
+    }
+
+    auto &merged = ranges.back();
+    uint16_t shift = r.start_address - merged.start_address;
+    bool bits = r.register_type == ModbusRegisterType::COIL || r.register_type == ModbusRegisterType::DISCRETE_INPUT;
+    // offset for coils is the number of the coil, for registers the byte offset
+    uint16_t offset_shift = bits ? shift : shift * 2;
+    std::vector<SensorItem *> sensors(r.sensors.begin(), r.sensors.end());
+    for (auto *sensor : sensors) {
+      // remove the sensor before changing start_address because it's part of the sort order
+      this->sensorset_.erase(sensor);
+      sensor->start_address = merged.start_address;
+      sensor->offset += offset_shift;
+      this->sensorset_.insert(sensor);
+      merged.sensors.insert(sensor);
+    }
+    merged.register_count = r.start_address + r.register_count - merged.start_address;
+    ESP_LOGV(TAG, "Merged range 0x%X into range 0x%X - %d registers", r.start_address, merged.start_address,
+             merged.register_count);
+  }
+  this->register_ranges_ = std::move(ranges);
+  return this->register_ranges_.size();
+}
+
+void ModbusController::create_sensor_tables_() {
+  for (auto &r : this->register_ranges_) {
+    r.sensor_table.clear();
+    r.sensor_table.reserve(r.sensors.size());
+    // sensors of a range share the start address, so the set is ordered by offset
+    for (auto *sensor : r.sensors) {
+      uint16_t data_end;
+      switch (r.register_type) {
+        case ModbusRegisterType::COIL:
+        case ModbusRegisterType::DISCRETE_INPUT:
+          // offset for coil is the actual number of the coil not the byte offset
+          data_end = sensor->offset / 8 + 1;
+          break;
+        case ModbusRegisterType::CUSTOM:
+          // the layout of custom responses is only known to the sensor
+          data_end = 0;
+          break;
+        default:
+          data_end = sensor->offset + sensor->get_register_size();
+          break;
+      }
+      r.sensor_table.push_back({sensor, data_end});
+    }
+  }
+}
+
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  ESP_LOGCONFIG(TAG, "  Max Register Gap: %u", this->max_register_gap_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -289,22 +413,8 @@ void ModbusController::dump_config() {
 #endif
 }
 
-void ModbusController::loop() {
-  // Incoming data to process?
-  if (!incoming_queue_.empty()) {
-    auto &message = incoming_queue_.front();
-    if (message != nullptr)
-      process_modbus_data_(message.get());
-    incoming_queue_.pop();
-
-  } else {
-    // all messages processed send pending commmands
-    send_next_command_();
-  }
-}
-
 void ModbusController::on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
-                                                  const std::vector<uint8_t> &data) {
+                                                  const ModbusDataView &data) {
   ESP_LOGV(TAG, "Command ACK 0x%X %d ", get_data<uint16_t>(data, 0), get_data<int16_t>(data, 1));
 }
 
@@ -318,7 +428,7 @@ void ModbusController::dump_sensors_() {
 
 ModbusCommandItem ModbusCommandItem::create_read_command(
     ModbusController *modbusdevice, ModbusRegisterType register_type, uint16_t start_address, uint16_t register_count,
-    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data)>
         &&handler) {
   ModbusCommandItem cmd;
   cmd.modbusdevice = modbusdevice;
@@ -340,7 +450,7 @@ ModbusCommandItem ModbusCommandItem::create_read_command(ModbusController *modbu
   cmd.register_address = start_address;
   cmd.register_count = register_count;
   cmd.on_data_func = [modbusdevice](ModbusRegisterType register_type, uint16_t start_address,
-                                    const std::vector<uint8_t> &data) {
+                                    const ModbusDataView &data) {
     modbusdevice->on_register_data(register_type, start_address, data);
   };
   return cmd;
@@ -356,7 +466,7 @@ ModbusCommandItem ModbusCommandItem::create_write_multiple_command(ModbusControl
   cmd.register_address = start_address;
   cmd.register_count = register_count;
   cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+                                         const ModbusDataView &data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
   for (auto v : values) {
@@ -375,7 +485,7 @@ ModbusCommandItem ModbusCommandItem::create_write_single_coil(ModbusController *
   cmd.register_address = address;
   cmd.register_count = 1;
   cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+                                         const ModbusDataView &data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
   cmd.payload.push_back(value ? 0xFF : 0);
@@ -392,7 +502,7 @@ ModbusCommandItem ModbusCommandItem::create_write_multiple_coils(ModbusControlle
   cmd.register_address = start_address;
   cmd.register_count = values.size();
   cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+                                         const ModbusDataView &data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
 
@@ -424,7 +534,7 @@ ModbusCommandItem ModbusCommandItem::create_write_single_command(ModbusControlle
   cmd.register_address = start_address;
   cmd.register_count = 1;  // not used here anyways
   cmd.on_data_func = [modbusdevice, cmd](ModbusRegisterType register_type, uint16_t start_address,
-                                         const std::vector<uint8_t> &data) {
+                                         const ModbusDataView &data) {
     modbusdevice->on_write_register_response(cmd.register_type, start_address, data);
   };
   cmd.payload.push_back((value / 256) & 0xFF);
@@ -434,13 +544,13 @@ ModbusCommandItem ModbusCommandItem::create_write_single_command(ModbusControlle
 
 ModbusCommandItem ModbusCommandItem::create_custom_command(
     ModbusController *modbusdevice, const std::vector<uint8_t> &values,
-    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+    std::function<void(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data)>
         &&handler) {
   ModbusCommandItem cmd;
   cmd.modbusdevice = modbusdevice;
   cmd.function_code = ModbusFunctionCode::CUSTOM;
   if (handler == nullptr) {
-    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+    cmd.on_data_func = [](ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data) {
       ESP_LOGI(TAG, "Custom Command sent");
     };
   } else {
@@ -507,7 +617,7 @@ std::vector<uint16_t> float_to_payload(float value, SensorValueType value_type)
   return data;
 }
 
-float payload_to_float(const std::vector<uint8_t> &data, SensorValueType sensor_value_type, uint8_t offset,
+float payload_to_float(const ModbusDataView &data, SensorValueType sensor_value_type, uint8_t offset,
                        uint32_t bitmask) {
   union {
     float float_value;
@@ -7,7 +7,6 @@
 
 #include <list>
 #include <set>
-#include <queue>
 #include <vector>
 
 namespace esphome {
@@ -145,6 +144,29 @@ inline uint64_t qword_from_hex_str(const std::string &value, uint8_t pos) {
   return static_cast<uint64_t>(dword_from_hex_str(value, pos)) << 32 | dword_from_hex_str(value, pos + 4);
 }
 
+/** The data of a modbus response, pointing into the receive buffer of the bus.
+ *
+ * It's only valid while the response is handled, copy it into a std::vector to keep it. A std::vector converts to and
+ * from it, so existing code that takes or passes on the data as a vector keeps working.
+ */
+class ModbusDataView {
+ public:
+  ModbusDataView(const uint8_t *data, size_t len) : data_(data), len_(len) {}
+  ModbusDataView(const std::vector<uint8_t> &data) : data_(data.data()), len_(data.size()) {}  // NOLINT
+  operator std::vector<uint8_t>() const { return std::vector<uint8_t>(this->begin(), this->end()); }  // NOLINT
+
+  const uint8_t *data() const { return this->data_; }
+  size_t size() const { return this->len_; }
+  bool empty() const { return this->len_ == 0; }
+  const uint8_t &operator[](size_t index) const { return this->data_[index]; }
+  const uint8_t *begin() const { return this->data_; }
+  const uint8_t *end() const { return this->data_ + this->len_; }
+
+ protected:
+  const uint8_t *data_;
+  size_t len_;
+};
+
 // Extract data from modbus response buffer
 /** Extract data from modbus response buffer
  * @param T one of supported integer data types int_8,int_16,int_32,int_64
@@ -152,7 +174,7 @@ inline uint64_t qword_from_hex_str(const std::string &value, uint8_t pos) {
  * @param buffer_offset  offset in bytes.
  * @return value of type T extracted from buffer
  */
-template<typename T> T get_data(const std::vector<uint8_t> &data, size_t buffer_offset) {
+template<typename T> T get_data(const ModbusDataView &data, size_t buffer_offset) {
   if (sizeof(T) == sizeof(uint8_t)) {
     return T(data[buffer_offset]);
   }
@@ -178,7 +200,7 @@ template<typename T> T get_data(const std::vector<uint8_t> &data, size_t buffer_
  * @param data modbus response buffer (uint8_t)
  * @return content of coil register
  */
-inline bool coil_from_vector(int coil, const std::vector<uint8_t> &data) {
+inline bool coil_from_vector(int coil, const ModbusDataView &data) {
   auto data_byte = coil / 8;
   return (data[data_byte] & (1 << (coil % 8))) > 0;
 }
@@ -212,21 +234,21 @@ template<typename N> N mask_and_shift_by_rightbit(N data, uint32_t mask) {
  */
 std::vector<uint16_t> float_to_payload(float value, SensorValueType value_type);
 
-/** convert vector<uint8_t> response payload to float
+/** convert the response payload to float
  * @param value float value to cconvert
  * @param sensor_value_type defines if 16/32/64 bits or FP32 is used
  * @param offset offset to the data in data
  * @param bitmask bitmask used for masking and shifting
  * @return float version of the input
  */
-float payload_to_float(const std::vector<uint8_t> &data, SensorValueType sensor_value_type, uint8_t offset,
+float payload_to_float(const ModbusDataView &data, SensorValueType sensor_value_type, uint8_t offset,
                        uint32_t bitmask);
 
 class ModbusController;
 
 class SensorItem {
  public:
-  virtual void parse_and_publish(const std::vector<uint8_t> &data) = 0;
+  virtual void parse_and_publish(const ModbusDataView &data) = 0;
 
   void set_custom_data(const std::vector<uint8_t> &data) { custom_data = data; }
   size_t virtual get_register_size() const {
@@ -283,13 +305,20 @@ class SensorItemsComparator {
 
 using SensorSet = std::set<SensorItem *, SensorItemsComparator>;
 
+/// Entry of the offset table of a RegisterRange
+struct RangeSensor {
+  SensorItem *sensor;
+  uint16_t data_end;  // number of response bytes needed to decode the sensor
+};
+
 struct RegisterRange {
   uint16_t start_address;
   ModbusRegisterType register_type;
   uint8_t register_count;
-  uint8_t skip_updates;          // the config value
-  SensorSet sensors;             // all sensors of this range
-  uint8_t skip_updates_counter;  // the running value
+  uint8_t skip_updates;                   // the config value
+  SensorSet sensors;                      // all sensors of this range
+  uint8_t skip_updates_counter;           // the running value
+  std::vector<RangeSensor> sensor_table;  // sensors ordered by offset, built once the ranges are final
 };
 
 class ModbusCommandItem {
@@ -301,13 +330,17 @@ class ModbusCommandItem {
   uint16_t register_count;
   ModbusFunctionCode function_code;
   ModbusRegisterType register_type;
-  std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+  std::function<void(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data)>
       on_data_func;
   std::vector<uint8_t> payload = {};
   bool send();
   // wrong commands (esp. custom commands) can block the send queue
   // limit the number of repeats
   uint8_t send_countdown{MAX_SEND_REPEATS};
+  /// millis() timestamp when the command was queued, used by the bus to send the oldest command first
+  uint32_t queued_at{0};
+  /// the register range read by this command, its response is decoded with the range's offset table
+  const RegisterRange *range{nullptr};
   /// factory methods
   /** Create modbus read command
    *  Function code 02-04
@@ -320,7 +353,7 @@ class ModbusCommandItem {
    */
   static ModbusCommandItem create_read_command(
       ModbusController *modbusdevice, ModbusRegisterType register_type, uint16_t start_address, uint16_t register_count,
-      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data)>
           &&handler);
   /** Create modbus read command
    *  Function code 02-04
@@ -380,7 +413,7 @@ class ModbusCommandItem {
    */
   static ModbusCommandItem create_custom_command(
       ModbusController *modbusdevice, const std::vector<uint8_t> &values,
-      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
+      std::function<void(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data)>
           &&handler = nullptr);
 };
 
@@ -396,38 +429,49 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  public:
   ModbusController(uint16_t throttle = 0) : command_throttle_(throttle){};
   void dump_config() override;
-  void loop() override;
   void setup() override;
   void update() override;
 
+  /// Report the time the command at the front of the send queue is due, called by the bus scheduler
+  bool get_next_deadline(uint32_t &deadline) override;
+  /// send the next modbus command from the send queue, called by the bus scheduler
+  void send_next_command() override;
+
   /// queues a modbus command in the send queue
   void queue_command(const ModbusCommandItem &command);
   /// Registers a sensor with the controller. Called by esphomes code generator
   void add_sensor_item(SensorItem *item) { sensorset_.insert(item); }
   /// called when a modbus response was parsed without errors
   void on_modbus_data(const std::vector<uint8_t> &data) override;
+  /// called when a modbus response was parsed without errors, data points into the receive buffer of the bus
+  void on_modbus_frame(const uint8_t *data, size_t len) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
-  /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
-  void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
-  /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
-  /// incoming queue
+  /// default delegate called when the response to a read command without a register range was received
+  void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const ModbusDataView &data);
+  /// default delegate called when the response to a write command was received
   void on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
-                                  const std::vector<uint8_t> &data);
+                                  const ModbusDataView &data);
   /// called by esphome generated code to set the command_throttle period
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
+  /// called by esphome generated code to set the maximum number of unused registers read to merge two ranges
+  void set_max_register_gap(uint16_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
 
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
-  // find register in sensormap. Returns iterator with all registers having the same start address
-  SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
+  /// merge neighbouring ranges if reading the unused registers between them is cheaper than another round trip
+  size_t coalesce_register_ranges_();
+  /// check whether \p next can be read together with \p range
+  bool can_coalesce_ranges_(const RegisterRange &range, const RegisterRange &next) const;
+  /// build the offset tables used to decode the responses of each range
+  void create_sensor_tables_();
   /// submit the read command for the address range to the send queue
   void update_range_(RegisterRange &r);
-  /// parse incoming modbus data
-  void process_modbus_data_(const ModbusCommandItem *response);
-  /// send the next modbus command from the send queue
-  bool send_next_command_();
+  /// decode the response for a range and publish the values of its sensors
+  void publish_range_(const RegisterRange &r, const ModbusDataView &data);
+  /// remove the command at the front of the queue, its list node is kept for the next command
+  void pop_command_();
   /// get the number of queued modbus commands (should be mostly empty)
   size_t get_command_queue_length_() { return command_queue_.size(); }
   /// dump the parsed sensormap for diagnostics
@@ -437,21 +481,23 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   /// Continous range of modbus registers
   std::vector<RegisterRange> register_ranges_;
   /// Hold the pending requests to be sent
-  std::list<std::unique_ptr<ModbusCommandItem>> command_queue_;
-  /// modbus response data waiting to get processed
-  std::queue<std::unique_ptr<ModbusCommandItem>> incoming_queue_;
+  std::list<ModbusCommandItem> command_queue_;
+  /// Nodes of finished commands, reused by queue_command() so scheduled commands don't allocate
+  std::list<ModbusCommandItem> command_pool_;
   /// when was the last send operation
-  uint32_t last_command_timestamp_;
+  uint32_t last_command_timestamp_{0};
   /// min time in ms between sending modbus commands
   uint16_t command_throttle_;
+  /// max number of unused registers between two ranges that are read with one command, 0 disables merging
+  uint16_t max_register_gap_{0};
 };
 
-/** convert vector<uint8_t> response payload to float
+/** convert the response payload to float
  * @param value float value to cconvert
  * @param item SensorItem object
  * @return float version of the input
  */
-inline float payload_to_float(const std::vector<uint8_t> &data, const SensorItem &item) {
+inline float payload_to_float(const ModbusDataView &data, const SensorItem &item) {
   return payload_to_float(data, item.sensor_value_type, item.offset, item.bitmask);
 }
 
@@ -7,7 +7,7 @@ namespace modbus_controller {
 
 static const char *const TAG = "modbus.number";
 
-void ModbusNumber::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusNumber::parse_and_publish(const ModbusDataView &data) {
   float result = payload_to_float(data, *this) / multiply_by_;
 
   // Is there a lambda registered
@@ -66,7 +66,7 @@ void ModbusNumber::control(float value) {
   }
   // publish new value
   write_cmd.on_data_func = [this, write_cmd, value](ModbusRegisterType register_type, uint16_t start_address,
-                                                    const std::vector<uint8_t> &data) {
+                                                    const ModbusDataView &data) {
     // gets called when the write command is ack'd from the device
     parent_->on_write_register_response(write_cmd.register_type, start_address, data);
     this->publish_state(value);
@@ -9,7 +9,7 @@ static const char *const TAG = "modbus_controller.sensor";
 
 void ModbusSensor::dump_config() { LOG_SENSOR(TAG, "Modbus Controller Sensor", this); }
 
-void ModbusSensor::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusSensor::parse_and_publish(const ModbusDataView &data) {
   float result = payload_to_float(data, *this);
 
   // Is there a lambda registered
@@ -21,9 +21,9 @@ class ModbusSensor : public Component, public sensor::Sensor, public SensorItem
     this->force_new_range = force_new_range;
   }
 
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(const ModbusDataView &data) override;
   void dump_config() override;
-  using transform_func_t = std::function<optional<float>(ModbusSensor *, float, const std::vector<uint8_t> &)>;
+  using transform_func_t = std::function<optional<float>(ModbusSensor *, float, const ModbusDataView &)>;
 
   void set_template(transform_func_t &&f) { this->transform_func_ = f; }
 
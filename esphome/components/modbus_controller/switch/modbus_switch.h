@@ -28,10 +28,10 @@ class ModbusSwitch : public Component, public switch_::Switch, public SensorItem
   void write_state(bool state) override;
   void dump_config() override;
   void set_state(bool state) { this->state = state; }
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(const ModbusDataView &data) override;
   void set_parent(ModbusController *parent) { this->parent_ = parent; }
 
-  using transform_func_t = std::function<optional<bool>(ModbusSwitch *, bool, const std::vector<uint8_t> &)>;
+  using transform_func_t = std::function<optional<bool>(ModbusSwitch *, bool, const ModbusDataView &)>;
   using write_transform_func_t = std::function<optional<bool>(ModbusSwitch *, bool, std::vector<uint8_t> &)>;
   void set_template(transform_func_t &&f) { this->publish_transform_func_ = f; }
   void set_write_template(write_transform_func_t &&f) { this->write_transform_func_ = f; }
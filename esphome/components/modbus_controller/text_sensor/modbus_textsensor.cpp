@@ -11,7 +11,7 @@ static const char *const TAG = "modbus_controller.text_sensor";
 
 void ModbusTextSensor::dump_config() { LOG_TEXT_SENSOR("", "Modbus Controller Text Sensor", this); }
 
-void ModbusTextSensor::parse_and_publish(const std::vector<uint8_t> &data) {
+void ModbusTextSensor::parse_and_publish(const ModbusDataView &data) {
   std::ostringstream output;
   uint8_t max_items = this->response_bytes;
   uint8_t index = this->offset;
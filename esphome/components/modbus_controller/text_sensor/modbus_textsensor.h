@@ -27,9 +27,9 @@ class ModbusTextSensor : public Component, public text_sensor::TextSensor, publi
 
   void dump_config() override;
 
-  void parse_and_publish(const std::vector<uint8_t> &data) override;
+  void parse_and_publish(const ModbusDataView &data) override;
   using transform_func_t =
-      std::function<optional<std::string>(ModbusTextSensor *, std::string, const std::vector<uint8_t> &)>;
+      std::function<optional<std::string>(ModbusTextSensor *, std::string, const ModbusDataView &)>;
   void set_template(transform_func_t &&f) { this->transform_func_ = f; }
 
  protected:
@@ -7,6 +7,13 @@ namespace esphome {
 namespace nextion {
 
 static const char *const TAG = "nextion";
+// Commands written to the display that may wait for their result at the same time. Assignments queued while the
+// display is busy are coalesced, so only their latest value is sent.
+static const size_t MAX_COMMANDS_IN_FLIGHT = 8;
+// Flush the batch buffer once it's this large, the display's serial buffer is 1024 bytes.
+static const size_t MAX_BATCH_SIZE = 256;
+// Stop holding back commands when the display doesn't report the end of a transparent transfer in time.
+static const uint32_t TRANSPARENT_TRANSFER_TIMEOUT = 1000;
 
 void Nextion::setup() {
   this->is_setup_ = false;
@@ -30,6 +37,17 @@ bool Nextion::send_command_(const std::string &command) {
     return false;
   }
 
+  // keep the order of commands
+  this->flush_pending_commands_(true);
+  if (this->transparent_transfer_) {
+    // The display would take the command as transfer data, it's written once the transfer is done
+    NextionQueue *entry = this->acquire_queue_entry_();
+    entry->command = command;
+    entry->wait_for_result = false;
+    this->pending_commands_.push_back(entry);
+    return true;
+  }
+
   ESP_LOGN(TAG, "send_command %s", command.c_str());
 
   this->write_str(command.c_str());
@@ -110,7 +128,13 @@ void Nextion::reset_(bool reset_nextion) {
   while (this->available()) {  // Clear receive buffer
     this->read_byte(&d);
   };
+  for (auto *entry : this->nextion_queue_)
+    this->release_queue_entry_(entry);
   this->nextion_queue_.clear();
+  for (auto *entry : this->pending_commands_)
+    this->release_queue_entry_(entry);
+  this->pending_commands_.clear();
+  this->transparent_transfer_ = false;
 }
 
 void Nextion::dump_config() {
@@ -184,11 +208,7 @@ bool Nextion::send_command_printf(const char *format, ...) {
     return false;
   }
 
-  if (this->send_command_(buffer)) {
-    this->add_no_result_to_queue_("send_command_printf");
-    return true;
-  }
-  return false;
+  return this->add_no_result_to_queue_with_command_("send_command_printf", buffer);
 }
 
 #ifdef NEXTION_PROTOCOL_LOG
@@ -238,6 +258,7 @@ void Nextion::loop() {
 
   this->process_serial_();            // Receive serial data
   this->process_nextion_commands_();  // Process nextion return commands
+  this->flush_pending_commands_();    // Send queued commands
 
   if (!this->nextion_reports_is_setup_) {
     if (this->started_ms_ == 0)
@@ -266,9 +287,8 @@ bool Nextion::remove_from_q_(bool report_empty) {
     if (component->get_variable_name() == "sleep_wake") {
       this->is_sleeping_ = false;
     }
-    delete component;  // NOLINT(cppcoreguidelines-owning-memory)
   }
-  delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
+  this->release_queue_entry_(nb);
   this->nextion_queue_.pop_front();
   return true;
 }
@@ -370,8 +390,7 @@ void Nextion::process_nextion_commands_() {
 
               found = index;
 
-              delete component;  // NOLINT(cppcoreguidelines-owning-memory)
-              delete nb;         // NOLINT(cppcoreguidelines-owning-memory)
+              this->release_queue_entry_(nb);
 
               break;
             }
@@ -482,7 +501,7 @@ void Nextion::process_nextion_commands_() {
           component->set_state_from_string(to_process, true, false);
         }
 
-        delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
+        this->release_queue_entry_(nb);
         this->nextion_queue_.pop_front();
 
         break;
@@ -528,7 +547,7 @@ void Nextion::process_nextion_commands_() {
           component->set_state_from_int(value, true, false);
         }
 
-        delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
+        this->release_queue_entry_(nb);
         this->nextion_queue_.pop_front();
 
         break;
@@ -680,6 +699,7 @@ void Nextion::process_nextion_commands_() {
       }
       case 0xFD: {  // data transparent transmit finished
         ESP_LOGVV(TAG, "Nextion reported data transmit finished!");
+        this->transparent_transfer_ = false;
         break;
       }
       case 0xFE: {  // data transparent transmit ready
@@ -705,8 +725,7 @@ void Nextion::process_nextion_commands_() {
                                                  component->get_wave_buffer().begin() + buffer_to_send);
             }
             found = index;
-            delete component;  // NOLINT(cppcoreguidelines-owning-memory)
-            delete nb;         // NOLINT(cppcoreguidelines-owning-memory)
+            this->release_queue_entry_(nb);
             break;
           }
           ++index;
@@ -753,10 +772,9 @@ void Nextion::process_nextion_commands_() {
           if (component->get_variable_name() == "sleep_wake") {
             this->is_sleeping_ = false;
           }
-          delete component;  // NOLINT(cppcoreguidelines-owning-memory)
         }
 
-        delete this->nextion_queue_[i];  // NOLINT(cppcoreguidelines-owning-memory)
+        this->release_queue_entry_(this->nextion_queue_[i]);
 
         this->nextion_queue_.erase(this->nextion_queue_.begin() + i);
         i--;
@@ -905,24 +923,87 @@ uint16_t Nextion::recv_ret_string_(std::string &response, uint32_t timeout, bool
   return ret;
 }
 
-/**
- * @brief
- *
- * @param variable_name Name for the queue
- */
-void Nextion::add_no_result_to_queue_(const std::string &variable_name) {
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion::NextionQueue *nextion_queue = new nextion::NextionQueue;
+NextionQueue *Nextion::acquire_queue_entry_() {
+  NextionQueue *entry;
+  if (this->queue_pool_.empty()) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    entry = new nextion::NextionQueue;
+  } else {
+    entry = this->queue_pool_.back();
+    this->queue_pool_.pop_back();
+  }
+  entry->component = &entry->no_result_component;
+  entry->queue_time = 0;
+  entry->command.clear();
+  entry->wait_for_result = true;
+  return entry;
+}
 
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion_queue->component = new nextion::NextionComponentBase;
-  nextion_queue->component->set_variable_name(variable_name);
+void Nextion::release_queue_entry_(NextionQueue *entry) { this->queue_pool_.push_back(entry); }
+
+void Nextion::queue_command_(NextionQueue *entry) {
+  // An assignment like "n0.val=5" replaces a pending assignment to the same variable, only the latest value matters.
+  // The old command is dropped and the new one appended, so the order of the latest writes is kept.
+  // A page change is a barrier, the same variable name on another page is another object.
+  const std::string &command = entry->command;
+  size_t assign = command.find('=');
+  if (assign != std::string::npos && command.find(' ') > assign) {
+    for (auto it = this->pending_commands_.end(); it != this->pending_commands_.begin();) {
+      --it;
+      const std::string &other = (*it)->command;
+      if (other.compare(0, 5, "page ") == 0)
+        break;
+      if (other.size() > assign && other[assign] == '=' && other.compare(0, assign, command, 0, assign) == 0) {
+        ESP_LOGN(TAG, "Replacing pending command %s", other.c_str());
+        this->release_queue_entry_(*it);
+        this->pending_commands_.erase(it);
+        break;
+      }
+    }
+  }
+  this->pending_commands_.push_back(entry);
+}
 
-  nextion_queue->queue_time = millis();
+void Nextion::flush_pending_commands_(bool ignore_window) {
+  uint32_t now = millis();
+  if (this->transparent_transfer_) {
+    // Anything written before the transfer is done would be taken as waveform data
+    if (now - this->transparent_transfer_start_ < TRANSPARENT_TRANSFER_TIMEOUT)
+      return;
+    ESP_LOGW(TAG, "Nextion didn't finish the transparent transfer, sending commands again");
+    this->transparent_transfer_ = false;
+  }
+  this->batch_buffer_.clear();
+  while (!this->pending_commands_.empty()) {
+    if (!ignore_window && this->is_setup_ && this->nextion_queue_.size() >= MAX_COMMANDS_IN_FLIGHT)
+      break;
 
-  this->nextion_queue_.push_back(nextion_queue);
+    NextionQueue *entry = this->pending_commands_.front();
+    this->pending_commands_.pop_front();
+    ESP_LOGN(TAG, "send_command %s", entry->command.c_str());
+    this->batch_buffer_ += entry->command;
+    this->batch_buffer_.append(3, static_cast<char>(0xFF));
+    entry->queue_time = now;
+    bool starts_transfer = entry->command.compare(0, 5, "addt ") == 0;
+    if (entry->wait_for_result) {
+      this->nextion_queue_.push_back(entry);
+    } else {
+      this->release_queue_entry_(entry);
+    }
 
-  ESP_LOGN(TAG, "Add to queue type: NORESULT component %s", nextion_queue->component->get_variable_name().c_str());
+    if (starts_transfer) {
+      // addt starts a transparent transfer, it ends the batch and the next commands wait until it is done
+      this->transparent_transfer_ = true;
+      this->transparent_transfer_start_ = now;
+      break;
+    }
+    if (this->batch_buffer_.size() >= MAX_BATCH_SIZE) {
+      this->write_array(reinterpret_cast<const uint8_t *>(this->batch_buffer_.data()), this->batch_buffer_.size());
+      this->batch_buffer_.clear();
+    }
+  }
+  if (!this->batch_buffer_.empty())
+    this->write_array(reinterpret_cast<const uint8_t *>(this->batch_buffer_.data()), this->batch_buffer_.size());
 }
 
 /**
@@ -931,13 +1012,17 @@ void Nextion::add_no_result_to_queue_(const std::string &variable_name) {
  * @param variable_name Variable name for the queue
  * @param command
  */
-void Nextion::add_no_result_to_queue_with_command_(const std::string &variable_name, const std::string &command) {
+bool Nextion::add_no_result_to_queue_with_command_(const std::string &variable_name, const std::string &command) {
   if ((!this->is_setup() && !this->ignore_is_setup_) || command.empty())
-    return;
+    return false;
 
-  if (this->send_command_(command)) {
-    this->add_no_result_to_queue_(variable_name);
-  }
+  NextionQueue *entry = this->acquire_queue_entry_();
+  entry->no_result_component.set_variable_name(variable_name);
+  entry->command = command;
+  this->queue_command_(entry);
+
+  ESP_LOGN(TAG, "Add to queue type: NORESULT component %s", variable_name.c_str());
+  return true;
 }
 
 bool Nextion::add_no_result_to_queue_with_ignore_sleep_printf_(const std::string &variable_name, const char *format,
@@ -955,8 +1040,7 @@ bool Nextion::add_no_result_to_queue_with_ignore_sleep_printf_(const std::string
     return false;
   }
 
-  this->add_no_result_to_queue_with_command_(variable_name, buffer);
-  return true;
+  return this->add_no_result_to_queue_with_command_(variable_name, buffer);
 }
 
 /**
@@ -980,8 +1064,7 @@ bool Nextion::add_no_result_to_queue_with_printf_(const std::string &variable_na
     return false;
   }
 
-  this->add_no_result_to_queue_with_command_(variable_name, buffer);
-  return true;
+  return this->add_no_result_to_queue_with_command_(variable_name, buffer);
 }
 
 /**
@@ -1045,20 +1128,15 @@ void Nextion::add_to_get_queue(NextionComponentBase *component) {
   if ((!this->is_setup() && !this->ignore_is_setup_))
     return;
 
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion::NextionQueue *nextion_queue = new nextion::NextionQueue;
-
-  nextion_queue->component = component;
-  nextion_queue->queue_time = millis();
+  NextionQueue *entry = this->acquire_queue_entry_();
+  entry->component = component;
+  entry->command = "get ";
+  entry->command += component->get_variable_name_to_send();
 
   ESP_LOGN(TAG, "Add to queue type: %s component %s", component->get_queue_type_string().c_str(),
            component->get_variable_name().c_str());
 
-  std::string command = "get " + component->get_variable_name_to_send();
-
-  if (this->send_command_(command)) {
-    this->nextion_queue_.push_back(nextion_queue);
-  }
+  this->queue_command_(entry);
 }
 
 /**
@@ -1073,21 +1151,15 @@ void Nextion::add_addt_command_to_queue(NextionComponentBase *component) {
   if ((!this->is_setup() && !this->ignore_is_setup_) || this->is_sleeping())
     return;
 
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion::NextionQueue *nextion_queue = new nextion::NextionQueue;
-
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion_queue->component = new nextion::NextionComponentBase;
-  nextion_queue->queue_time = millis();
+  NextionQueue *entry = this->acquire_queue_entry_();
+  entry->no_result_component.set_variable_name("");
 
   size_t buffer_to_send = component->get_wave_buffer_size() < 255 ? component->get_wave_buffer_size()
                                                                   : 255;  // ADDT command can only send 255
 
-  std::string command = "addt " + to_string(component->get_component_id()) + "," +
-                        to_string(component->get_wave_channel_id()) + "," + to_string(buffer_to_send);
-  if (this->send_command_(command)) {
-    this->nextion_queue_.push_back(nextion_queue);
-  }
+  entry->command = "addt " + to_string(component->get_component_id()) + "," +
+                   to_string(component->get_wave_channel_id()) + "," + to_string(buffer_to_send);
+  this->queue_command_(entry);
 }
 
 void Nextion::set_writer(const nextion_writer_t &writer) { this->writer_ = writer; }
@@ -728,7 +728,27 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
   void set_auto_wake_on_touch_internal(bool auto_wake_on_touch) { this->auto_wake_on_touch_ = auto_wake_on_touch; }
 
  protected:
+  /// Commands written to the display that wait for their result.
   std::deque<NextionQueue *> nextion_queue_;
+  /// Commands waiting to be written to the display, see flush_pending_commands_().
+  std::deque<NextionQueue *> pending_commands_;
+  /// Released queue entries that are reused for new commands.
+  std::vector<NextionQueue *> queue_pool_;
+  /// Commands written together with one UART write.
+  std::string batch_buffer_;
+  /// Whether an addt command was written and the display hasn't finished the transparent transfer yet.
+  bool transparent_transfer_{false};
+  uint32_t transparent_transfer_start_{0};
+  /// Get an unused queue entry, its component is set to the entry's own no_result_component.
+  NextionQueue *acquire_queue_entry_();
+  void release_queue_entry_(NextionQueue *entry);
+  /// Add an entry to the pending commands, replacing a pending assignment to the same variable.
+  void queue_command_(NextionQueue *entry);
+  /**
+   * Write pending commands to the display, several per UART write.
+   * @param ignore_window Write all pending commands, even if many commands are still waiting for their result.
+   */
+  void flush_pending_commands_(bool ignore_window = false);
   uint16_t recv_ret_string_(std::string &response, uint32_t timeout, bool recv_flag);
   void all_components_send_state_(bool force_update = false);
   uint64_t comok_sent_ = 0;
@@ -753,10 +773,9 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
    * @param command The command to write, for example "vis b0,0".
    */
   bool send_command_(const std::string &command);
-  void add_no_result_to_queue_(const std::string &variable_name);
   bool add_no_result_to_queue_with_ignore_sleep_printf_(const std::string &variable_name, const char *format, ...)
       __attribute__((format(printf, 3, 4)));
-  void add_no_result_to_queue_with_command_(const std::string &variable_name, const std::string &command);
+  bool add_no_result_to_queue_with_command_(const std::string &variable_name, const std::string &command);
 
   bool add_no_result_to_queue_with_printf_(const std::string &variable_name, const char *format, ...)
       __attribute__((format(printf, 3, 4)));
@@ -1,5 +1,7 @@
 #pragma once
+#include <string>
 #include <utility>
+#include <vector>
 #include "esphome/core/defines.h"
 
 namespace esphome {
@@ -17,15 +19,6 @@ enum NextionQueueType {
 static const char *const NEXTION_QUEUE_TYPE_STRINGS[] = {"NO_RESULT", "SENSOR",      "BINARY_SENSOR",
                                                          "SWITCH",    "TEXT_SENSOR", "WAVEFORM_SENSOR"};
 
-class NextionComponentBase;
-
-class NextionQueue {
- public:
-  virtual ~NextionQueue() = default;
-  NextionComponentBase *component;
-  uint32_t queue_time = 0;
-};
-
 class NextionComponentBase {
  public:
   virtual ~NextionComponentBase() = default;
@@ -91,5 +84,19 @@ class NextionComponentBase {
 
   bool needs_to_send_update_;
 };
+
+class NextionQueue {
+ public:
+  virtual ~NextionQueue() = default;
+  NextionComponentBase *component;
+  uint32_t queue_time = 0;
+  /// The command of this entry. Kept until it's written to the display, so a later assignment to the same variable
+  /// can replace it.
+  std::string command;
+  /// Component of commands that don't return a result, so they don't need an allocation of their own.
+  NextionComponentBase no_result_component;
+  /// Whether the display's response to this command is waited for once it is written.
+  bool wait_for_result = true;
+};
 }  // namespace nextion
 }  // namespace esphome
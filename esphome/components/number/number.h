@@ -81,7 +81,9 @@ class Number : public EntityBase {
   NumberCall make_call() { return NumberCall(this); }
   void set(float value) { make_call().set_value(value).perform(); }
 
-  void add_on_state_callback(std::function<void(float)> &&callback);
+  template<typename F> void add_on_state_callback(F &&callback) {
+    this->state_callback_.add(std::forward<F>(callback));
+  }
 
   NumberTraits traits;
 
@@ -13,6 +13,8 @@ class OTABackend {
   virtual OTAResponseTypes end() = 0;
   virtual void abort() = 0;
   virtual bool supports_compression() = 0;
+  /// Called before begin() when the client sends a gzip compressed image, only if supports_compression() is true.
+  virtual void set_compressed(bool compressed) {}
 };
 
 }  // namespace ota
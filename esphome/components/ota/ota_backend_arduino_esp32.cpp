@@ -11,6 +11,25 @@ namespace esphome {
 namespace ota {
 
 OTAResponseTypes ArduinoESP32OTABackend::begin(size_t image_size) {
+  if (this->compressed_) {
+    // The image is larger than what's received, so the final size isn't known yet
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN, U_FLASH))
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    if (image_size > Update.size()) {
+      Update.abort();
+      return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+    }
+    if (!this->decompressor_.begin([](const uint8_t *data, size_t len) {
+          size_t written = Update.write(const_cast<uint8_t *>(data), len);
+          return written == len ? OTA_RESPONSE_OK : OTA_RESPONSE_ERROR_WRITING_FLASH;
+        })) {
+      Update.abort();
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+    this->md5_.init();
+    return OTA_RESPONSE_OK;
+  }
+
   bool ret = Update.begin(image_size, U_FLASH);
   if (ret) {
     return OTA_RESPONSE_OK;
@@ -22,9 +41,19 @@ OTAResponseTypes ArduinoESP32OTABackend::begin(size_t image_size) {
   return OTA_RESPONSE_ERROR_UNKNOWN;
 }
 
-void ArduinoESP32OTABackend::set_update_md5(const char *md5) { Update.setMD5(md5); }
+void ArduinoESP32OTABackend::set_update_md5(const char *md5) {
+  if (this->compressed_) {
+    memcpy(this->expected_bin_md5_, md5, 32);
+  } else {
+    Update.setMD5(md5);
+  }
+}
 
 OTAResponseTypes ArduinoESP32OTABackend::write(uint8_t *data, size_t len) {
+  if (this->compressed_) {
+    this->md5_.add(data, len);
+    return this->decompressor_.write(data, len);
+  }
   size_t written = Update.write(data, len);
   if (written != len) {
     return OTA_RESPONSE_ERROR_WRITING_FLASH;
@@ -33,12 +62,30 @@ OTAResponseTypes ArduinoESP32OTABackend::write(uint8_t *data, size_t len) {
 }
 
 OTAResponseTypes ArduinoESP32OTABackend::end() {
+  if (this->compressed_) {
+    this->md5_.calculate();
+    OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UPDATE_END;
+    if (this->md5_.equals_hex(this->expected_bin_md5_))
+      error_code = this->decompressor_.end();
+    this->decompressor_.release();
+    if (error_code != OTA_RESPONSE_OK) {
+      Update.abort();
+      return error_code;
+    }
+    // The size given to begin() was the whole partition
+    if (!Update.end(true))
+      return OTA_RESPONSE_ERROR_UPDATE_END;
+    return OTA_RESPONSE_OK;
+  }
   if (!Update.end())
     return OTA_RESPONSE_ERROR_UPDATE_END;
   return OTA_RESPONSE_OK;
 }
 
-void ArduinoESP32OTABackend::abort() { Update.abort(); }
+void ArduinoESP32OTABackend::abort() {
+  Update.abort();
+  this->decompressor_.release();
+}
 
 }  // namespace ota
 }  // namespace esphome
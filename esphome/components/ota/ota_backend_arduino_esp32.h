@@ -4,6 +4,8 @@
 
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_decompressor.h"
+#include "esphome/components/md5/md5.h"
 
 namespace esphome {
 namespace ota {
@@ -15,7 +17,15 @@ class ArduinoESP32OTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
-  bool supports_compression() override { return false; }
+  bool supports_compression() override { return true; }
+  void set_compressed(bool compressed) override { this->compressed_ = compressed; }
+
+ protected:
+  // The updater checks the MD5 of the written (decompressed) image, compressed uploads are checked here instead.
+  md5::MD5Digest md5_{};
+  char expected_bin_md5_[32];
+  bool compressed_{false};
+  OTADecompressor decompressor_;
 };
 
 }  // namespace ota
@@ -9,12 +9,28 @@
 namespace esphome {
 namespace ota {
 
+#ifndef OTA_WITH_SEQUENTIAL_WRITES
+static const size_t FLASH_SECTOR_SIZE = 4096;
+#endif
+
 OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
   this->partition_ = esp_ota_get_next_update_partition(nullptr);
   if (this->partition_ == nullptr) {
     return OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION;
   }
-  esp_err_t err = esp_ota_begin(this->partition_, image_size, &this->update_handle_);
+  // A compressed image is larger than what's received, that is only known to be too large once it is written
+  if (image_size > this->partition_->size)
+    return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+  // Erasing the whole image at once blocks for seconds, so the flash is erased while the image arrives
+#ifdef OTA_WITH_SEQUENTIAL_WRITES
+  size_t erase_size = OTA_WITH_SEQUENTIAL_WRITES;
+#else
+  // Only the first sector, write_flash_() erases the others
+  size_t erase_size = FLASH_SECTOR_SIZE;
+  this->erased_size_ = FLASH_SECTOR_SIZE;
+  this->written_size_ = 0;
+#endif
+  esp_err_t err = esp_ota_begin(this->partition_, erase_size, &this->update_handle_);
   if (err != ESP_OK) {
     esp_ota_abort(this->update_handle_);
     this->update_handle_ = 0;
@@ -25,6 +41,11 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
     }
     return OTA_RESPONSE_ERROR_UNKNOWN;
   }
+  if (this->compressed_ &&
+      !this->decompressor_.begin([this](const uint8_t *data, size_t len) { return this->write_flash_(data, len); })) {
+    this->abort();
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
   this->md5_.init();
   return OTA_RESPONSE_OK;
 }
@@ -32,8 +53,27 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
 void IDFOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
 
 OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
-  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
+  // The MD5 is of the image as it was sent
   this->md5_.add(data, len);
+  if (this->compressed_)
+    return this->decompressor_.write(data, len);
+  return this->write_flash_(data, len);
+}
+
+OTAResponseTypes IDFOTABackend::write_flash_(const uint8_t *data, size_t len) {
+  esp_err_t err = ESP_OK;
+#ifndef OTA_WITH_SEQUENTIAL_WRITES
+  // One sector at a time, this runs in the writer task so the loop task keeps feeding the watchdog
+  while (err == ESP_OK && this->written_size_ + len > this->erased_size_) {
+    if (this->erased_size_ >= this->partition_->size)
+      return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+    err = esp_partition_erase_range(this->partition_, this->erased_size_, FLASH_SECTOR_SIZE);
+    this->erased_size_ += FLASH_SECTOR_SIZE;
+  }
+  this->written_size_ += len;
+#endif
+  if (err == ESP_OK)
+    err = esp_ota_write(this->update_handle_, data, len);
   if (err != ESP_OK) {
     if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
       return OTA_RESPONSE_ERROR_MAGIC;
@@ -51,6 +91,14 @@ OTAResponseTypes IDFOTABackend::end() {
     this->abort();
     return OTA_RESPONSE_ERROR_UPDATE_END;
   }
+  if (this->compressed_) {
+    OTAResponseTypes error_code = this->decompressor_.end();
+    this->decompressor_.release();
+    if (error_code != OTA_RESPONSE_OK) {
+      this->abort();
+      return error_code;
+    }
+  }
   esp_err_t err = esp_ota_end(this->update_handle_);
   this->update_handle_ = 0;
   if (err == ESP_OK) {
@@ -71,6 +119,7 @@ OTAResponseTypes IDFOTABackend::end() {
 void IDFOTABackend::abort() {
   esp_ota_abort(this->update_handle_);
   this->update_handle_ = 0;
+  this->decompressor_.release();
 }
 
 }  // namespace ota
@@ -4,6 +4,7 @@
 
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_decompressor.h"
 #include <esp_ota_ops.h>
 #include "esphome/components/md5/md5.h"
 
@@ -17,13 +18,23 @@ class IDFOTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
-  bool supports_compression() override { return false; }
+  bool supports_compression() override { return true; }
+  void set_compressed(bool compressed) override { this->compressed_ = compressed; }
 
  private:
+  OTAResponseTypes write_flash_(const uint8_t *data, size_t len);
+
   esp_ota_handle_t update_handle_{0};
   const esp_partition_t *partition_;
   md5::MD5Digest md5_{};
   char expected_bin_md5_[32];
+  bool compressed_{false};
+#ifndef OTA_WITH_SEQUENTIAL_WRITES
+  /// Bytes at the start of the partition that are erased and written.
+  size_t erased_size_{0};
+  size_t written_size_{0};
+#endif
+  OTADecompressor decompressor_;
 };
 
 }  // namespace ota
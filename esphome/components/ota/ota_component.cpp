@@ -3,6 +3,7 @@
 #include "ota_backend_arduino_esp32.h"
 #include "ota_backend_arduino_esp8266.h"
 #include "ota_backend_esp_idf.h"
+#include "ota_writer.h"
 
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
@@ -119,6 +120,9 @@ void OTAComponent::handle_() {
   size_t ota_size;
   uint8_t ota_features;
   std::unique_ptr<OTABackend> backend;
+  OTAWriter writer;
+  uint8_t *write_buf = nullptr;
+  size_t write_len = 0;
   (void) ota_features;
 
   if (client_ == nullptr) {
@@ -173,6 +177,7 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_HEADER_OK;
   if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
     buf[0] = OTA_RESPONSE_SUPPORTS_COMPRESSION;
+    backend->set_compressed(true);
   }
 
   this->writeall_(buf, 1);
@@ -274,14 +279,24 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
+  if (!writer.begin(backend.get())) {
+    ESP_LOGW(TAG, "Not enough memory for receive buffers");
+    error_code = OTA_RESPONSE_ERROR_UNKNOWN;
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+
   while (total < ota_size) {
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
+    if (write_buf == nullptr) {
+      write_buf = writer.get_buffer();
+      write_len = 0;
+    }
+    size_t requested = std::min(OTA_WRITER_BUFFER_SIZE - write_len, ota_size - total);
+    ssize_t read = this->client_->read(write_buf + write_len, requested);
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
-        delay(1);
+        this->client_->wait_readable(100);
         continue;
       }
       ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
@@ -294,12 +309,16 @@ void OTAComponent::handle_() {
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
 
-    error_code = backend->write(buf, read);
-    if (error_code != OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!");
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
     total += read;
+    write_len += read;
+    if (write_len == OTA_WRITER_BUFFER_SIZE || total == ota_size) {
+      error_code = writer.write(write_buf, write_len);
+      write_buf = nullptr;
+      if (error_code != OTA_RESPONSE_OK) {
+        ESP_LOGW(TAG, "Error writing binary data to flash!");
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    }
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
@@ -315,6 +334,13 @@ void OTAComponent::handle_() {
     }
   }
 
+  error_code = writer.flush();
+  writer.end();
+  if (error_code != OTA_RESPONSE_OK) {
+    ESP_LOGW(TAG, "Error writing binary data to flash!");
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
@@ -352,6 +378,8 @@ error:
   this->client_->close();
   this->client_ = nullptr;
 
+  // the backend may still be written to
+  writer.end();
   if (backend != nullptr && update_started) {
     backend->abort();
   }
@@ -376,7 +404,7 @@ bool OTAComponent::readall_(uint8_t *buf, size_t len) {
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
-        delay(1);
+        this->client_->wait_readable(100);
         continue;
       }
       ESP_LOGW(TAG, "Failed to read %d bytes of data, errno: %d", len, errno);
@@ -388,7 +416,6 @@ bool OTAComponent::readall_(uint8_t *buf, size_t len) {
       at += read;
     }
     App.feed_wdt();
-    delay(1);
   }
 
   return true;
@@ -0,0 +1,230 @@
+#include "esphome/core/defines.h"
+#ifdef USE_ESP32
+
+#include "ota_decompressor.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+// The inflate implementation in ROM, only the header of the current target is on the include path.
+#if __has_include(<esp32/rom/miniz.h>)
+#include <esp32/rom/miniz.h>
+#elif __has_include(<esp32s2/rom/miniz.h>)
+#include <esp32s2/rom/miniz.h>
+#elif __has_include(<esp32s3/rom/miniz.h>)
+#include <esp32s3/rom/miniz.h>
+#elif __has_include(<esp32c3/rom/miniz.h>)
+#include <esp32c3/rom/miniz.h>
+#else
+#include <rom/miniz.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.decompressor";
+
+static const uint8_t GZIP_HEADER_SIZE = 10;
+static const uint8_t GZIP_TRAILER_SIZE = 8;
+static const uint8_t GZIP_METHOD_DEFLATE = 8;
+static const uint8_t GZIP_FLAG_HEADER_CRC = 0x02;
+static const uint8_t GZIP_FLAG_EXTRA = 0x04;
+static const uint8_t GZIP_FLAG_NAME = 0x08;
+static const uint8_t GZIP_FLAG_COMMENT = 0x10;
+static const uint8_t GZIP_FLAG_RESERVED = 0xE0;
+
+bool OTADecompressor::begin(Sink &&sink) {
+  this->release();
+  // Prefer external RAM if there is any, this is about 43 KB
+  using InflatorAllocator = ExternalRAMAllocator<tinfl_decompressor>;
+  using WindowAllocator = ExternalRAMAllocator<uint8_t>;
+  this->inflator_ = InflatorAllocator(InflatorAllocator::ALLOW_FAILURE).allocate(1);
+  this->window_ = WindowAllocator(WindowAllocator::ALLOW_FAILURE).allocate(TINFL_LZ_DICT_SIZE);
+  if (this->inflator_ == nullptr || this->window_ == nullptr) {
+    ESP_LOGW(TAG, "Not enough memory for decompression");
+    this->release();
+    return false;
+  }
+  tinfl_init(static_cast<tinfl_decompressor *>(this->inflator_));
+  this->sink_ = std::move(sink);
+  this->window_pos_ = 0;
+  this->window_flushed_ = 0;
+  this->total_out_ = 0;
+  this->state_ = State::HEADER;
+  this->flags_ = 0;
+  this->field_pos_ = 0;
+  this->extra_remaining_ = 0;
+  return true;
+}
+
+void OTADecompressor::release() {
+  if (this->inflator_ != nullptr)
+    ExternalRAMAllocator<tinfl_decompressor>().deallocate(static_cast<tinfl_decompressor *>(this->inflator_), 1);
+  if (this->window_ != nullptr)
+    ExternalRAMAllocator<uint8_t>().deallocate(this->window_, TINFL_LZ_DICT_SIZE);
+  this->inflator_ = nullptr;
+  this->window_ = nullptr;
+}
+
+OTAResponseTypes OTADecompressor::write(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    size_t consumed = 0;
+    OTAResponseTypes error_code = this->state_ == State::DEFLATE ? this->inflate_(data, len, &consumed)
+                                                                 : this->parse_framing_(data, len, &consumed);
+    if (error_code != OTA_RESPONSE_OK)
+      return error_code;
+    if (consumed == 0)
+      break;  // ignore anything after the end of the image
+    data += consumed;
+    len -= consumed;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes OTADecompressor::end() {
+  if (this->state_ != State::DONE) {
+    ESP_LOGW(TAG, "Compressed image is incomplete");
+    return OTA_RESPONSE_ERROR_UPDATE_END;
+  }
+  ESP_LOGD(TAG, "Decompressed image is %u bytes", this->total_out_);
+  return OTA_RESPONSE_OK;
+}
+
+void OTADecompressor::next_header_field_() {
+  this->field_pos_ = 0;
+  if (this->flags_ & GZIP_FLAG_EXTRA) {
+    this->state_ = State::EXTRA_LENGTH;
+  } else if (this->flags_ & GZIP_FLAG_NAME) {
+    this->state_ = State::NAME;
+  } else if (this->flags_ & GZIP_FLAG_COMMENT) {
+    this->state_ = State::COMMENT;
+  } else if (this->flags_ & GZIP_FLAG_HEADER_CRC) {
+    this->state_ = State::HEADER_CRC;
+  } else {
+    this->state_ = State::DEFLATE;
+  }
+}
+
+OTAResponseTypes OTADecompressor::parse_framing_(const uint8_t *data, size_t len, size_t *consumed) {
+  size_t used = 0;
+  while (used < len) {
+    switch (this->state_) {
+      case State::HEADER:
+        this->field_[this->field_pos_++] = data[used++];
+        if (this->field_pos_ == GZIP_HEADER_SIZE) {
+          if (this->field_[0] != 0x1F || this->field_[1] != 0x8B || this->field_[2] != GZIP_METHOD_DEFLATE ||
+              (this->field_[3] & GZIP_FLAG_RESERVED) != 0) {
+            ESP_LOGW(TAG, "Invalid gzip header");
+            return OTA_RESPONSE_ERROR_MAGIC;
+          }
+          this->flags_ = this->field_[3];
+          this->next_header_field_();
+        }
+        break;
+      case State::EXTRA_LENGTH:
+        this->field_[this->field_pos_++] = data[used++];
+        if (this->field_pos_ == 2) {
+          this->extra_remaining_ = encode_uint16(this->field_[1], this->field_[0]);
+          this->state_ = State::EXTRA;
+        }
+        break;
+      case State::EXTRA: {
+        size_t skip = std::min<size_t>(this->extra_remaining_, len - used);
+        used += skip;
+        this->extra_remaining_ -= skip;
+        if (this->extra_remaining_ == 0) {
+          this->flags_ &= ~GZIP_FLAG_EXTRA;
+          this->next_header_field_();
+        }
+        break;
+      }
+      case State::NAME:
+      case State::COMMENT:
+        // zero terminated strings
+        if (data[used++] == 0) {
+          this->flags_ &= this->state_ == State::NAME ? ~GZIP_FLAG_NAME : ~GZIP_FLAG_COMMENT;
+          this->next_header_field_();
+        }
+        break;
+      case State::HEADER_CRC:
+        used++;
+        if (++this->field_pos_ == 2) {
+          this->flags_ &= ~GZIP_FLAG_HEADER_CRC;
+          this->next_header_field_();
+        }
+        break;
+      case State::TRAILER:
+        this->field_[this->field_pos_++] = data[used++];
+        if (this->field_pos_ == GZIP_TRAILER_SIZE) {
+          // CRC32 followed by the decompressed size, the MD5 of the upload already covers the data itself
+          uint32_t size = encode_uint32(this->field_[7], this->field_[6], this->field_[5], this->field_[4]);
+          if (size != this->total_out_) {
+            ESP_LOGW(TAG, "Decompressed size %u doesn't match expected size %u", this->total_out_, size);
+            return OTA_RESPONSE_ERROR_UPDATE_END;
+          }
+          this->state_ = State::DONE;
+        }
+        break;
+      case State::DEFLATE:
+      case State::DONE:
+        *consumed = used;
+        return OTA_RESPONSE_OK;
+    }
+  }
+  *consumed = used;
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes OTADecompressor::inflate_(const uint8_t *data, size_t len, size_t *consumed) {
+  auto *inflator = static_cast<tinfl_decompressor *>(this->inflator_);
+  *consumed = 0;
+  while (true) {
+    size_t in_bytes = len - *consumed;
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - this->window_pos_;
+    tinfl_status status = tinfl_decompress(inflator, data + *consumed, &in_bytes, this->window_,
+                                           this->window_ + this->window_pos_, &out_bytes, TINFL_FLAG_HAS_MORE_INPUT);
+    *consumed += in_bytes;
+    this->window_pos_ += out_bytes;
+    this->total_out_ += out_bytes;
+
+    if (status < TINFL_STATUS_DONE) {
+      ESP_LOGW(TAG, "Decompression failed: %d", status);
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+    OTAResponseTypes error_code = this->flush_(status == TINFL_STATUS_DONE);
+    if (error_code != OTA_RESPONSE_OK)
+      return error_code;
+
+    if (status == TINFL_STATUS_DONE) {
+      this->state_ = State::TRAILER;
+      this->field_pos_ = 0;
+      return OTA_RESPONSE_OK;
+    }
+    if (status == TINFL_STATUS_NEEDS_MORE_INPUT)
+      return OTA_RESPONSE_OK;
+    // TINFL_STATUS_HAS_MORE_OUTPUT: the window is full, continue at its start
+  }
+}
+
+OTAResponseTypes OTADecompressor::flush_(bool all) {
+  while (this->window_pos_ - this->window_flushed_ >= OTA_DECOMPRESSOR_BLOCK_SIZE ||
+         (all && this->window_pos_ > this->window_flushed_)) {
+    size_t len = std::min(OTA_DECOMPRESSOR_BLOCK_SIZE, this->window_pos_ - this->window_flushed_);
+    OTAResponseTypes error_code = this->sink_(this->window_ + this->window_flushed_, len);
+    if (error_code != OTA_RESPONSE_OK)
+      return error_code;
+    this->window_flushed_ += len;
+  }
+  // The window size is a multiple of the block size, so everything is flushed once it's full
+  if (this->window_pos_ == TINFL_LZ_DICT_SIZE) {
+    this->window_pos_ = 0;
+    this->window_flushed_ = 0;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,76 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_ESP32
+
+#include "ota_component.h"
+
+#include <functional>
+
+namespace esphome {
+namespace ota {
+
+/// Size of the blocks the decompressed image is written to flash in.
+static const size_t OTA_DECOMPRESSOR_BLOCK_SIZE = 4096;
+
+/** Streaming decompressor for gzip compressed OTA images.
+ *
+ * Uses the inflate implementation in ROM with a 32 KB window buffer, which is the largest back reference deflate
+ * allows. The window doubles as output buffer: decompressed data is passed to the sink in blocks of
+ * OTA_DECOMPRESSOR_BLOCK_SIZE bytes, so flash is written in whole sectors.
+ */
+class OTADecompressor {
+ public:
+  using Sink = std::function<OTAResponseTypes(const uint8_t *data, size_t len)>;
+
+  ~OTADecompressor() { this->release(); }
+
+  /// Allocate the buffers and prepare for a new image, returns false if there's not enough memory.
+  bool begin(Sink &&sink);
+  /// Decompress the next chunk of the compressed image.
+  OTAResponseTypes write(const uint8_t *data, size_t len);
+  /// Check the whole image was received and decompressed correctly.
+  OTAResponseTypes end();
+  /// Free the buffers.
+  void release();
+
+ protected:
+  enum class State : uint8_t {
+    HEADER,
+    EXTRA_LENGTH,
+    EXTRA,
+    NAME,
+    COMMENT,
+    HEADER_CRC,
+    DEFLATE,
+    TRAILER,
+    DONE,
+  };
+
+  /// Consume gzip header or trailer bytes, stops at the start of the compressed data.
+  OTAResponseTypes parse_framing_(const uint8_t *data, size_t len, size_t *consumed);
+  /// Move on to the next optional header field that's present, or to the compressed data.
+  void next_header_field_();
+  OTAResponseTypes inflate_(const uint8_t *data, size_t len, size_t *consumed);
+  /// Pass all complete blocks in the window to the sink, or everything if \p all is set.
+  OTAResponseTypes flush_(bool all);
+
+  Sink sink_;
+  void *inflator_{nullptr};
+  uint8_t *window_{nullptr};
+  /// Write position in the window.
+  size_t window_pos_{0};
+  /// Start of the data in the window that hasn't been passed to the sink yet.
+  size_t window_flushed_{0};
+  uint32_t total_out_{0};
+  State state_{State::HEADER};
+  uint8_t flags_{0};
+  /// Bytes of the current header field (or trailer) collected so far.
+  uint8_t field_[10];
+  uint16_t field_pos_{0};
+  uint16_t extra_remaining_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
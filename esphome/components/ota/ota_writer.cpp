@@ -0,0 +1,128 @@
+#include "ota_writer.h"
+
+#include "esphome/core/application.h"
+
+#include <new>
+
+namespace esphome {
+namespace ota {
+
+#ifdef USE_ESP32
+// The decompressor and the flash driver need some stack
+static const uint32_t WRITE_TASK_STACK_SIZE = 8192;
+
+bool OTAWriter::begin(OTABackend *backend) {
+  this->end();
+  this->backend_ = backend;
+  this->error_code_ = OTA_RESPONSE_OK;
+  this->buffers_.reset(new (std::nothrow) uint8_t[OTA_WRITER_NUM_BUFFERS * OTA_WRITER_BUFFER_SIZE]);  // NOLINT
+  if (!this->buffers_)
+    return false;
+
+  // One more entry than buffers, for the marker the task sends when it stops
+  this->free_queue_ = xQueueCreate(OTA_WRITER_NUM_BUFFERS + 1, sizeof(uint8_t *));
+  this->write_queue_ = xQueueCreate(OTA_WRITER_NUM_BUFFERS + 1, sizeof(Block));
+  if (this->free_queue_ == nullptr || this->write_queue_ == nullptr) {
+    this->end();
+    return false;
+  }
+  for (uint8_t i = 0; i < OTA_WRITER_NUM_BUFFERS; i++) {
+    uint8_t *buffer = this->buffers_.get() + i * OTA_WRITER_BUFFER_SIZE;
+    xQueueSend(this->free_queue_, &buffer, 0);
+  }
+
+  if (xTaskCreate(&OTAWriter::write_task, "ota_writer", WRITE_TASK_STACK_SIZE, this, uxTaskPriorityGet(nullptr),
+                  &this->task_) != pdPASS) {
+    this->task_ = nullptr;
+    this->end();
+    return false;
+  }
+  return true;
+}
+
+uint8_t *OTAWriter::get_buffer() {
+  uint8_t *buffer;
+  while (xQueueReceive(this->free_queue_, &buffer, pdMS_TO_TICKS(100)) != pdTRUE)
+    App.feed_wdt();
+  return buffer;
+}
+
+OTAResponseTypes OTAWriter::write(uint8_t *buffer, size_t len) {
+  Block block{buffer, len};
+  xQueueSend(this->write_queue_, &block, portMAX_DELAY);
+  return this->error_code_;
+}
+
+OTAResponseTypes OTAWriter::flush() {
+  // All writes are done once every buffer is back
+  uint8_t *buffers[OTA_WRITER_NUM_BUFFERS];
+  for (auto &buffer : buffers)
+    buffer = this->get_buffer();
+  for (auto *buffer : buffers)
+    xQueueSend(this->free_queue_, &buffer, 0);
+  return this->error_code_;
+}
+
+void OTAWriter::end() {
+  if (this->task_ != nullptr) {
+    Block stop{nullptr, 0};
+    xQueueSend(this->write_queue_, &stop, portMAX_DELAY);
+    uint8_t *buffer;
+    do {
+      buffer = this->get_buffer();
+    } while (buffer != nullptr);
+    this->task_ = nullptr;
+  }
+  if (this->free_queue_ != nullptr) {
+    vQueueDelete(this->free_queue_);
+    this->free_queue_ = nullptr;
+  }
+  if (this->write_queue_ != nullptr) {
+    vQueueDelete(this->write_queue_);
+    this->write_queue_ = nullptr;
+  }
+  this->buffers_.reset();
+}
+
+void OTAWriter::write_task(void *params) {
+  auto *writer = reinterpret_cast<OTAWriter *>(params);
+  Block block;
+  while (true) {
+    xQueueReceive(writer->write_queue_, &block, portMAX_DELAY);
+    if (block.data == nullptr)
+      break;
+    // Skip everything after an error, the update is aborted anyway
+    if (writer->error_code_ == OTA_RESPONSE_OK)
+      writer->error_code_ = writer->backend_->write(block.data, block.len);
+    xQueueSend(writer->free_queue_, &block.data, portMAX_DELAY);
+  }
+  uint8_t *stopped = nullptr;
+  xQueueSend(writer->free_queue_, &stopped, portMAX_DELAY);
+  vTaskDelete(nullptr);
+}
+
+#else  // USE_ESP32
+
+bool OTAWriter::begin(OTABackend *backend) {
+  this->backend_ = backend;
+  this->error_code_ = OTA_RESPONSE_OK;
+  this->buffers_.reset(new (std::nothrow) uint8_t[OTA_WRITER_BUFFER_SIZE]);  // NOLINT
+  return static_cast<bool>(this->buffers_);
+}
+
+uint8_t *OTAWriter::get_buffer() { return this->buffers_.get(); }
+
+OTAResponseTypes OTAWriter::write(uint8_t *buffer, size_t len) {
+  if (this->error_code_ == OTA_RESPONSE_OK)
+    this->error_code_ = this->backend_->write(buffer, len);
+  return this->error_code_;
+}
+
+OTAResponseTypes OTAWriter::flush() { return this->error_code_; }
+
+void OTAWriter::end() { this->buffers_.reset(); }
+
+#endif  // USE_ESP32
+
+}  // namespace ota
+}  // namespace esphome
@@ -0,0 +1,67 @@
+#pragma once
+#include "esphome/core/defines.h"
+
+#include "ota_component.h"
+#include "ota_backend.h"
+
+#include <memory>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+#ifdef USE_ESP32
+/// Size of the buffers the received image is collected in, one flash sector.
+static const size_t OTA_WRITER_BUFFER_SIZE = 4096;
+static const uint8_t OTA_WRITER_NUM_BUFFERS = 2;
+#else
+/// The updater already collects a flash sector, so small buffers are enough.
+static const size_t OTA_WRITER_BUFFER_SIZE = 1024;
+static const uint8_t OTA_WRITER_NUM_BUFFERS = 1;
+#endif
+
+/** Passes the received image to the backend.
+ *
+ * On ESP32 the backend is called from a separate task with two buffers, so the next buffer is received while the
+ * previous one is written to flash. Elsewhere a buffer is written as soon as it's full.
+ */
+class OTAWriter {
+ public:
+  ~OTAWriter() { this->end(); }
+
+  /// Allocate the buffers and start writing to \p backend, returns false if that failed.
+  bool begin(OTABackend *backend);
+  /// Get an empty buffer of OTA_WRITER_BUFFER_SIZE bytes, waits until a previous write is done if needed.
+  uint8_t *get_buffer();
+  /// Write the first \p len bytes of a buffer from get_buffer(). Returns the first error of any write so far.
+  OTAResponseTypes write(uint8_t *buffer, size_t len);
+  /// Wait until all writes are done, and return the first error of any of them.
+  OTAResponseTypes flush();
+  /// Stop writing and free the buffers. Must be called before the backend is ended or aborted.
+  void end();
+
+ protected:
+  OTABackend *backend_{nullptr};
+  std::unique_ptr<uint8_t[]> buffers_;
+  OTAResponseTypes error_code_{OTA_RESPONSE_OK};
+#ifdef USE_ESP32
+  struct Block {
+    uint8_t *data;
+    size_t len;
+  };
+
+  static void write_task(void *params);
+
+  QueueHandle_t free_queue_{nullptr};
+  QueueHandle_t write_queue_{nullptr};
+  TaskHandle_t task_{nullptr};
+#endif
+};
+
+}  // namespace ota
+}  // namespace esphome
@@ -3,340 +3,369 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+enum ScrapeSection : uint8_t {
+  SECTION_SENSOR = 0,
+  SECTION_BINARY_SENSOR,
+  SECTION_FAN,
+  SECTION_LIGHT,
+  SECTION_COVER,
+  SECTION_SWITCH,
+  SECTION_LOCK,
+  SECTION_DONE,
+};
+
+static void add_labels(std::vector<std::string> &labels, EntityBase *obj) {
+  if (obj->is_internal()) {
+    // Internal entities aren't exported, but keep their slot so the indices line up.
+    labels.emplace_back();
+    return;
+  }
+  std::string label = "id=\"";
+  label += obj->get_object_id();
+  label += "\",name=\"";
+  label += obj->get_name();
+  label += '"';
+  labels.push_back(std::move(label));
+}
+
+/// Start a data point of metric \p name for the entity with \p labels, more labels can be appended to it.
+static void begin_metric(std::string &out, const char *name, const std::string &labels) {
+  out += name;
+  out += '{';
+  out += labels;
+}
+/// Finish a data point started with begin_metric() with \p value.
+static void end_metric(std::string &out, const char *value) {
+  out += "} ";
+  out += value;
+  out += '\n';
+}
+static void end_metric(std::string &out, const std::string &value) { end_metric(out, value.c_str()); }
+static void end_metric(std::string &out, bool value) { end_metric(out, value ? "1" : "0"); }
+static void end_metric(std::string &out, int value) {
+  char buf[12];
+  snprintf(buf, sizeof(buf), "%d", value);
+  end_metric(out, buf);
+}
+static void end_metric(std::string &out, float value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.2f", value);
+  end_metric(out, buf);
+}
 
+void PrometheusHandler::render_labels_() {
+  this->labels_.clear();
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    add_labels(this->labels_, obj);
 #endif
-
 #ifdef USE_LOCK
-  this->lock_type_(stream);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+    add_labels(this->labels_, obj);
+#endif
+  this->labels_.shrink_to_fit();
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // The metrics are rendered piece by piece whenever the connection can take more data, so that the complete
+  // response never has to be held in memory.
+  auto state = std::make_shared<ScrapeState>();
+  AsyncWebServerResponse *response =
+      req->beginChunkedResponse("text/plain; version=0.0.4; charset=utf-8",
+                                [this, state](uint8_t *buf, size_t max_len, size_t /*index*/) -> size_t {
+                                  return this->fill_(*state, buf, max_len);
+                                });
+  req->send(response);
+}
+
+size_t PrometheusHandler::fill_(ScrapeState &state, uint8_t *buf, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (state.pending_offset == state.pending.size()) {
+      // Everything rendered so far is sent, reuse the buffer for the next piece.
+      state.pending.clear();
+      state.pending_offset = 0;
+      if (!this->render_next_(state))
+        break;
+      continue;
+    }
+    size_t len = std::min(max_len - written, state.pending.size() - state.pending_offset);
+    memcpy(buf + written, state.pending.data() + state.pending_offset, len);
+    state.pending_offset += len;
+    written += len;
+  }
+  return written;
+}
+
+bool PrometheusHandler::render_next_(ScrapeState &state) {
+  while (state.section != SECTION_DONE) {
+    switch (state.section) {
+#ifdef USE_SENSOR
+      case SECTION_SENSOR:
+        if (this->render_section_(state, App.get_sensors(), &PrometheusHandler::sensor_type_,
+                                  &PrometheusHandler::sensor_row_))
+          return true;
+        break;
+#endif
+#ifdef USE_BINARY_SENSOR
+      case SECTION_BINARY_SENSOR:
+        if (this->render_section_(state, App.get_binary_sensors(), &PrometheusHandler::binary_sensor_type_,
+                                  &PrometheusHandler::binary_sensor_row_))
+          return true;
+        break;
+#endif
+#ifdef USE_FAN
+      case SECTION_FAN:
+        if (this->render_section_(state, App.get_fans(), &PrometheusHandler::fan_type_, &PrometheusHandler::fan_row_))
+          return true;
+        break;
+#endif
+#ifdef USE_LIGHT
+      case SECTION_LIGHT:
+        if (this->render_section_(state, App.get_lights(), &PrometheusHandler::light_type_,
+                                  &PrometheusHandler::light_row_))
+          return true;
+        break;
 #endif
+#ifdef USE_COVER
+      case SECTION_COVER:
+        if (this->render_section_(state, App.get_covers(), &PrometheusHandler::cover_type_,
+                                  &PrometheusHandler::cover_row_))
+          return true;
+        break;
+#endif
+#ifdef USE_SWITCH
+      case SECTION_SWITCH:
+        if (this->render_section_(state, App.get_switches(), &PrometheusHandler::switch_type_,
+                                  &PrometheusHandler::switch_row_))
+          return true;
+        break;
+#endif
+#ifdef USE_LOCK
+      case SECTION_LOCK:
+        if (this->render_section_(state, App.get_locks(), &PrometheusHandler::lock_type_,
+                                  &PrometheusHandler::lock_row_))
+          return true;
+        break;
+#endif
+      default:
+        break;
+    }
+    state.section++;
+    state.index = 0;
+  }
+  return false;
+}
 
-  req->send(stream);
+template<typename T>
+bool PrometheusHandler::render_section_(ScrapeState &state, const std::vector<T *> &objs,
+                                        void (PrometheusHandler::*type)(std::string &),
+                                        void (PrometheusHandler::*row)(std::string &, T *, const std::string &)) {
+  if (state.index == 0) {
+    (this->*type)(state.pending);
+  } else if (state.index <= objs.size()) {
+    T *obj = objs[state.index - 1];
+    const std::string &labels = this->labels_[state.label_index++];
+    if (!obj->is_internal())
+      (this->*row)(state.pending, obj, labels);
+  } else {
+    return false;
+  }
+  state.index++;
+  return true;
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value GAUGE\n";
+  out += "#TYPE esphome_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_metric(out, "esphome_sensor_failed", labels);
+    end_metric(out, "0");
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    begin_metric(out, "esphome_sensor_value", labels);
+    out += ",unit=\"";
+    out += obj->get_unit_of_measurement();
+    out += '"';
+    end_metric(out, value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()));
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_metric(out, "esphome_sensor_failed", labels);
+    end_metric(out, "1");
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value GAUGE\n";
+  out += "#TYPE esphome_binary_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const std::string &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_metric(out, "esphome_binary_sensor_failed", labels);
+    end_metric(out, "0");
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    begin_metric(out, "esphome_binary_sensor_value", labels);
+    end_metric(out, obj->state);
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_metric(out, "esphome_binary_sensor_failed", labels);
+    end_metric(out, "1");
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value GAUGE\n";
+  out += "#TYPE esphome_fan_failed GAUGE\n";
+  out += "#TYPE esphome_fan_speed GAUGE\n";
+  out += "#TYPE esphome_fan_oscillation GAUGE\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj, const std::string &labels) {
+  begin_metric(out, "esphome_fan_failed", labels);
+  end_metric(out, "0");
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  begin_metric(out, "esphome_fan_value", labels);
+  end_metric(out, obj->state);
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
+    begin_metric(out, "esphome_fan_speed", labels);
+    end_metric(out, obj->speed);
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
+    begin_metric(out, "esphome_fan_oscillation", labels);
+    end_metric(out, obj->oscillating);
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state GAUGE\n";
+  out += "#TYPE esphome_light_color GAUGE\n";
+  out += "#TYPE esphome_light_effect_active GAUGE\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  begin_metric(out, "esphome_light_state", labels);
+  end_metric(out, obj->remote_values.is_on());
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  begin_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"brightness\"";
+  end_metric(out, brightness);
+  begin_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"r\"";
+  end_metric(out, r);
+  begin_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"g\"";
+  end_metric(out, g);
+  begin_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"b\"";
+  end_metric(out, b);
+  begin_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"w\"";
+  end_metric(out, w);
   // Effect
   std::string effect = obj->get_effect_name();
-  if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
-  } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
-  }
+  begin_metric(out, "esphome_light_effect_active", labels);
+  out += ",effect=\"";
+  out += effect;
+  out += '"';
+  end_metric(out, effect == "None" ? "0" : "1");
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value GAUGE\n";
+  out += "#TYPE esphome_cover_failed GAUGE\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_metric(out, "esphome_cover_failed", labels);
+    end_metric(out, "0");
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
+    begin_metric(out, "esphome_cover_value", labels);
+    end_metric(out, obj->position);
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(obj->get_object_id().c_str());
-      stream->print(F("\",name=\""));
-      stream->print(obj->get_name().c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
+      begin_metric(out, "esphome_cover_tilt", labels);
+      end_metric(out, obj->tilt);
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_metric(out, "esphome_cover_failed", labels);
+    end_metric(out, "1");
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value GAUGE\n";
+  out += "#TYPE esphome_switch_failed GAUGE\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  begin_metric(out, "esphome_switch_failed", labels);
+  end_metric(out, "0");
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  begin_metric(out, "esphome_switch_value", labels);
+  end_metric(out, obj->state);
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value GAUGE\n";
+  out += "#TYPE esphome_lock_failed GAUGE\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj, const std::string &labels) {
+  begin_metric(out, "esphome_lock_failed", labels);
+  end_metric(out, "0");
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  begin_metric(out, "esphome_lock_value", labels);
+  end_metric(out, static_cast<int>(obj->state));
 }
 #endif
 
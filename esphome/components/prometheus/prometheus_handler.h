@@ -6,6 +6,9 @@
 #include "esphome/core/controller.h"
 #include "esphome/core/component.h"
 
+#include <string>
+#include <vector>
+
 namespace esphome {
 namespace prometheus {
 
@@ -25,6 +28,7 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   void handleRequest(AsyncWebServerRequest *req) override;
 
   void setup() override {
+    this->render_labels_();
     this->base_->init();
     this->base_->add_handler(this);
   }
@@ -34,56 +38,77 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   }
 
  protected:
+  /// Progress of a single scrape, which is rendered incrementally as the connection accepts more data.
+  struct ScrapeState {
+    uint8_t section{0};        ///< The entity domain that's currently rendered
+    size_t index{0};           ///< 0 for the type header of the section, otherwise the entity index + 1
+    size_t label_index{0};     ///< Index into labels_ of the next entity
+    std::string pending;       ///< Rendered output that hasn't been sent yet
+    size_t pending_offset{0};  ///< Number of bytes of pending that have already been sent
+  };
+
+  /// Render the labels of all entities, which don't change after setup.
+  void render_labels_();
+  /// Copy as much of the scrape output into \p buf as fits, rendering more as needed. Returns 0 once done.
+  size_t fill_(ScrapeState &state, uint8_t *buf, size_t max_len);
+  /// Render the next type header or entity into the pending output, return false when everything has been rendered.
+  bool render_next_(ScrapeState &state);
+  template<typename T>
+  bool render_section_(ScrapeState &state, const std::vector<T *> &objs, void (PrometheusHandler::*type)(std::string &),
+                       void (PrometheusHandler::*row)(std::string &, T *, const std::string &));
+
 #ifdef USE_SENSOR
   /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
+  void sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
+  void sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
+  void binary_sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
+  void fan_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj);
+  void fan_row_(std::string &out, fan::Fan *obj, const std::string &labels);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
+  void light_type_(std::string &out);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
+  void light_row_(std::string &out, light::LightState *obj, const std::string &labels);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
+  void cover_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
+  void cover_row_(std::string &out, cover::Cover *obj, const std::string &labels);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
+  void switch_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
+  void switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels);
 #endif
 
 #ifdef USE_LOCK
   /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
+  void lock_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
+  void lock_row_(std::string &out, lock::Lock *obj, const std::string &labels);
 #endif
 
   web_server_base::WebServerBase *base_;
+  /// The id and name labels of every entity, in the order they're rendered in.
+  std::vector<std::string> labels_;
 };
 
 }  // namespace prometheus
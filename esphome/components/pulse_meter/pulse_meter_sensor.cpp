@@ -1,13 +1,32 @@
 #include "pulse_meter_sensor.h"
 #include "esphome/core/log.h"
 
+#ifdef HAS_PCNT
+#include <soc/pcnt_struct.h>
+#endif
+
 namespace esphome {
 namespace pulse_meter {
 
 static const char *const TAG = "pulse_meter";
 
+#ifdef HAS_PCNT
+/// The batch size is increased until the PCNT interrupt fires at most this often.
+static const uint32_t MIN_CAPTURE_INTERVAL_US = 1000;
+/// Go back to an interrupt per edge if the batch takes longer than this, the rate has probably dropped.
+static const uint32_t MAX_CAPTURE_INTERVAL_US = 1000000;
+static const int16_t MAX_PCNT_BATCH = 16384;
+#endif
+
 void PulseMeterSensor::setup() {
   this->pin_->setup();
+#ifdef HAS_PCNT
+  if (this->use_pcnt_) {
+    if (!this->setup_pcnt_())
+      this->mark_failed();
+    return;
+  }
+#endif
   this->isr_pin_ = pin_->to_isr();
   this->pin_->attach_interrupt(PulseMeterSensor::gpio_intr, this, gpio::INTERRUPT_ANY_EDGE);
 
@@ -16,6 +35,10 @@ void PulseMeterSensor::setup() {
 }
 
 void PulseMeterSensor::loop() {
+#ifdef HAS_PCNT
+  if (this->use_pcnt_)
+    this->read_pcnt_();
+#endif
   const uint32_t now = micros();
 
   // If we've exceeded our timeout interval without receiving any pulses, assume 0 pulses/min until
@@ -27,15 +50,23 @@ void PulseMeterSensor::loop() {
     this->pulse_width_us_ = 0;
   }
 
-  // We quantize our pulse widths to 1 ms to avoid unnecessary jitter
-  const uint32_t pulse_width_ms = this->pulse_width_us_ / 1000;
-  if (this->pulse_width_dedupe_.next(pulse_width_ms)) {
-    if (pulse_width_ms == 0) {
+  // We quantize our pulse widths to 1 ms to avoid unnecessary jitter. The PCNT widths may well be shorter than that,
+  // they are quantized to a power of two microseconds of about 1% of the width.
+  const uint32_t pulse_width_us = this->pulse_width_us_;
+  uint32_t quantum_us = 1000;
+  if (this->use_pcnt_ && pulse_width_us < 1000) {
+    quantum_us = 1;
+    while (quantum_us * 2 <= pulse_width_us / 100)
+      quantum_us *= 2;
+  }
+  const uint32_t pulse_width = pulse_width_us - pulse_width_us % quantum_us;
+  if (this->pulse_width_dedupe_.next(pulse_width)) {
+    if (pulse_width == 0) {
       // Treat 0 pulse width as 0 pulses/min (normally because we've not detected any pulses for a while)
       this->publish_state(0);
     } else {
-      // Calculate pulses/min from the pulse width in ms
-      this->publish_state((60.0f * 1000.0f) / pulse_width_ms);
+      // Calculate pulses/min from the pulse width
+      this->publish_state((60.0f * 1000000.0f) / pulse_width);
     }
   }
 
@@ -52,6 +83,10 @@ void PulseMeterSensor::set_total_pulses(uint32_t pulses) { this->total_pulses_ =
 void PulseMeterSensor::dump_config() {
   LOG_SENSOR("", "Pulse Meter", this);
   LOG_PIN("  Pin: ", this->pin_);
+#ifdef HAS_PCNT
+  if (this->use_pcnt_)
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->pcnt_unit_);
+#endif
   ESP_LOGCONFIG(TAG, "  Filtering pulses shorter than %u µs", this->filter_us_);
   ESP_LOGCONFIG(TAG, "  Assuming 0 pulses/min after not receiving a pulse for %us", this->timeout_us_ / 1000000);
 }
@@ -81,5 +116,143 @@ void IRAM_ATTR PulseMeterSensor::gpio_intr(PulseMeterSensor *sensor) {
   sensor->last_detected_edge_us_ = now;
 }
 
+#ifdef HAS_PCNT
+bool PulseMeterSensor::setup_pcnt_() {
+  // Take the units from the end, pulse_counter takes them from the start
+  static pcnt_unit_t next_pcnt_unit = pcnt_unit_t(int(PCNT_UNIT_MAX) - 1);
+  this->pcnt_unit_ = next_pcnt_unit;
+  next_pcnt_unit = pcnt_unit_t(int(next_pcnt_unit) - 1);
+
+  // Count rising edges, the counter resets and interrupts every pcnt_batch_ edges
+  pcnt_config_t pcnt_config = {
+      .pulse_gpio_num = this->pin_->get_pin(),
+      .ctrl_gpio_num = PCNT_PIN_NOT_USED,
+      .lctrl_mode = PCNT_MODE_KEEP,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DIS,
+      .counter_h_lim = this->pcnt_batch_,
+      .counter_l_lim = 0,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_0,
+  };
+  esp_err_t error = pcnt_unit_config(&pcnt_config);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring PCNT failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  if (this->filter_us_ != 0) {
+    uint16_t filter_val = std::min(static_cast<unsigned int>(this->filter_us_ * 80u), 1023u);
+    error = pcnt_set_filter_value(this->pcnt_unit_, filter_val);
+    if (error == ESP_OK)
+      error = pcnt_filter_enable(this->pcnt_unit_);
+    if (error != ESP_OK) {
+      ESP_LOGE(TAG, "Enabling PCNT filter failed: %s", esp_err_to_name(error));
+      return false;
+    }
+  }
+
+  // The interrupt service is shared by all units, another component may have installed it already
+  error = pcnt_isr_service_install(0);
+  if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "Installing PCNT interrupt service failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  error = pcnt_isr_handler_add(this->pcnt_unit_, PulseMeterSensor::pcnt_intr, this);
+  if (error == ESP_OK)
+    error = pcnt_event_enable(this->pcnt_unit_, PCNT_EVT_H_LIM);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Adding PCNT interrupt failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  error = pcnt_counter_pause(this->pcnt_unit_);
+  if (error == ESP_OK)
+    error = pcnt_counter_clear(this->pcnt_unit_);
+  if (error == ESP_OK)
+    error = pcnt_counter_resume(this->pcnt_unit_);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Starting PCNT failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  return true;
+}
+
+void PulseMeterSensor::read_pcnt_() {
+  uint32_t edges = 0;
+  uint32_t duration_us = 0;
+  while (this->capture_tail_ != this->capture_head_) {
+    const uint8_t tail = this->capture_tail_;
+    const EdgeCapture capture{this->captures_[tail].time_us, this->captures_[tail].edges};
+    this->capture_tail_ = (tail + 1) % CAPTURE_BUFFER_SIZE;
+    // Don't measure the first capture (we need two to measure the width), or the first after a timeout
+    if (this->last_capture_.time_us != 0 && capture.time_us - this->last_capture_.time_us <= this->timeout_us_) {
+      edges += capture.edges - this->last_capture_.edges;
+      duration_us += capture.time_us - this->last_capture_.time_us;
+    }
+    this->last_capture_ = capture;
+  }
+
+  if (edges != 0) {
+    const uint32_t pulse_width_us = duration_us / edges;
+    this->pulse_width_us_ = pulse_width_us;
+    this->last_valid_edge_us_ = this->last_capture_.time_us;
+    // Fewer interrupts at high rates, the timestamps are averaged over the whole batch anyway
+    if (pulse_width_us * this->pcnt_batch_ < MIN_CAPTURE_INTERVAL_US / 2 && this->pcnt_batch_ < MAX_PCNT_BATCH) {
+      const uint32_t batch = MIN_CAPTURE_INTERVAL_US / std::max(pulse_width_us, uint32_t(1));
+      this->set_pcnt_batch_(std::min(batch, uint32_t(MAX_PCNT_BATCH)));
+    }
+  } else if (this->pcnt_batch_ > 1 && micros() - this->last_capture_.time_us > MAX_CAPTURE_INTERVAL_US) {
+    this->set_pcnt_batch_(1);
+  }
+
+  // Read the edges the interrupt counted first, the counter may reset and add to it in between
+  const uint32_t interrupt_edges = this->pcnt_edges_;
+  int16_t count;
+  pcnt_get_counter_value(this->pcnt_unit_, &count);
+  const uint32_t counted = interrupt_edges + count;
+  if (int32_t(counted - this->pcnt_counted_) > 0) {
+    this->total_pulses_ += counted - this->pcnt_counted_;
+    this->pcnt_counted_ = counted;
+  }
+}
+
+void PulseMeterSensor::set_pcnt_batch_(int16_t batch) {
+  ESP_LOGV(TAG, "Interrupting every %d edges", batch);
+  // Move what's counted so far to pcnt_edges_, the new limit only applies after the counter is cleared
+  InterruptLock lock;
+  int16_t count;
+  pcnt_get_counter_value(this->pcnt_unit_, &count);
+  pcnt_set_event_value(this->pcnt_unit_, PCNT_EVT_H_LIM, batch);
+  pcnt_counter_clear(this->pcnt_unit_);
+  // The counter may have reset after the old number of edges with the interrupt still pending, handle it here so
+  // that it isn't counted with the new batch size
+  const uint32_t unit_mask = 1u << this->pcnt_unit_;
+  if (PCNT.int_st.val & unit_mask) {
+    PCNT.int_clr.val = unit_mask;
+    PulseMeterSensor::pcnt_intr(this);
+  }
+  this->pcnt_edges_ += count;
+  this->pcnt_batch_ = batch;
+}
+
+void IRAM_ATTR PulseMeterSensor::pcnt_intr(void *arg) {
+  auto *sensor = reinterpret_cast<PulseMeterSensor *>(arg);
+  const uint32_t now = micros();
+
+  // The counter has just reset after pcnt_batch_ edges
+  sensor->pcnt_edges_ += sensor->pcnt_batch_;
+  const uint8_t head = sensor->capture_head_;
+  const uint8_t next = (head + 1) % CAPTURE_BUFFER_SIZE;
+  // If loop() is behind, drop this capture, the next one includes its edges
+  if (next != sensor->capture_tail_) {
+    sensor->captures_[head].time_us = now;
+    sensor->captures_[head].edges = sensor->pcnt_edges_;
+    sensor->capture_head_ = next;
+  }
+}
+#endif
+
 }  // namespace pulse_meter
 }  // namespace esphome
@@ -5,6 +5,11 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/helpers.h"
 
+#if defined(USE_ESP32) && !defined(USE_ESP32_VARIANT_ESP32C3)
+#include <driver/pcnt.h>
+#define HAS_PCNT
+#endif
+
 namespace esphome {
 namespace pulse_meter {
 
@@ -14,6 +19,8 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   void set_filter_us(uint32_t filter) { this->filter_us_ = filter; }
   void set_timeout_us(uint32_t timeout) { this->timeout_us_ = timeout; }
   void set_total_sensor(sensor::Sensor *sensor) { this->total_sensor_ = sensor; }
+  /// Count the pulses with the PCNT peripheral instead of an interrupt per edge.
+  void set_use_pcnt(bool use_pcnt) { this->use_pcnt_ = use_pcnt; }
 
   void set_total_pulses(uint32_t pulses);
 
@@ -25,7 +32,37 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
  protected:
   static void gpio_intr(PulseMeterSensor *sensor);
 
+#ifdef HAS_PCNT
+  /// The number of edges counted up to some time.
+  struct EdgeCapture {
+    uint32_t time_us;
+    uint32_t edges;
+  };
+  static const uint8_t CAPTURE_BUFFER_SIZE = 16;
+
+  bool setup_pcnt_();
+  /// Compute the pulse width from the captures the interrupt made since the last loop.
+  void read_pcnt_();
+  /// Change the number of edges between interrupts.
+  void set_pcnt_batch_(int16_t batch);
+  static void pcnt_intr(void *arg);
+
+  pcnt_unit_t pcnt_unit_;
+  /// The counter resets and interrupts every this many edges.
+  volatile int16_t pcnt_batch_ = 1;
+  /// Edges counted by the interrupt, and when the counter was reset by changing the batch size.
+  volatile uint32_t pcnt_edges_ = 0;
+  /// Edges included in total_pulses_ so far.
+  uint32_t pcnt_counted_ = 0;
+  /// Ring buffer the interrupt adds a capture to every time the counter resets.
+  volatile EdgeCapture captures_[CAPTURE_BUFFER_SIZE];
+  volatile uint8_t capture_head_ = 0;
+  volatile uint8_t capture_tail_ = 0;
+  EdgeCapture last_capture_{0, 0};
+#endif
+
   InternalGPIOPin *pin_ = nullptr;
+  bool use_pcnt_ = false;
   ISRInternalGPIOPin isr_pin_;
   uint32_t filter_us_ = 0;
   uint32_t timeout_us_ = 1000000UL * 60UL * 5UL;
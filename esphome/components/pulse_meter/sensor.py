@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation, pins
 from esphome.components import sensor
+from esphome.components.esp32 import is_esp32c3
 from esphome.const import (
     CONF_ID,
     CONF_INTERNAL_FILTER,
@@ -20,6 +21,8 @@ from esphome.core import CORE
 
 CODEOWNERS = ["@stevebaxter"]
 
+CONF_USE_PCNT = "use_pcnt"
+
 pulse_meter_ns = cg.esphome_ns.namespace("pulse_meter")
 
 PulseMeterSensor = pulse_meter_ns.class_(
@@ -49,6 +52,18 @@ def validate_pulse_meter_pin(value):
     return value
 
 
+def validate_use_pcnt(config):
+    if not config[CONF_USE_PCNT]:
+        return config
+    if not CORE.is_esp32 or is_esp32c3():
+        raise cv.Invalid("PCNT is only available on ESP32 variants that have it")
+    if config[CONF_INTERNAL_FILTER].total_microseconds > 13:
+        raise cv.Invalid(
+            "Maximum internal filter value with PCNT is 13us", [CONF_INTERNAL_FILTER]
+        )
+    return config
+
+
 CONFIG_SCHEMA = sensor.sensor_schema(
     unit_of_measurement=UNIT_PULSES_PER_MINUTE,
     icon=ICON_PULSE,
@@ -66,8 +81,9 @@ CONFIG_SCHEMA = sensor.sensor_schema(
             accuracy_decimals=0,
             state_class=STATE_CLASS_TOTAL_INCREASING,
         ),
+        cv.Optional(CONF_USE_PCNT, default=False): cv.boolean,
     }
-)
+).add_extra(validate_use_pcnt)
 
 
 async def to_code(config):
@@ -79,6 +95,8 @@ async def to_code(config):
     cg.add(var.set_pin(pin))
     cg.add(var.set_filter_us(config[CONF_INTERNAL_FILTER]))
     cg.add(var.set_timeout_us(config[CONF_TIMEOUT]))
+    if config[CONF_USE_PCNT]:
+        cg.add(var.set_use_pcnt(True))
 
     if CONF_TOTAL in config:
         sens = await sensor.new_sensor(config[CONF_TOTAL])
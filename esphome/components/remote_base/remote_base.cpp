@@ -24,6 +24,8 @@ void RemoteRMTChannel::config_rmt(rmt_config_t &rmt) {
 }
 #endif
 
+uint32_t RemoteReceiverBase::next_burst_ = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 void RemoteReceiverBinarySensorBase::dump_config() { LOG_BINARY_SENSOR("", "Remote Receiver Binary Sensor", this); }
 
 void RemoteTransmitterBase::send_(uint32_t send_times, uint32_t send_wait) {
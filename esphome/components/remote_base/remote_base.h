@@ -56,7 +56,8 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance) : data_(data), tolerance_(tolerance) {}
+  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance, uint32_t burst = 0)
+      : data_(data), tolerance_(tolerance), burst_(burst) {}
 
   bool peek_mark(uint32_t length, uint32_t offset = 0) {
     if (int32_t(this->index_ + offset) >= this->size())
@@ -136,6 +137,9 @@ class RemoteReceiveData {
 
   std::vector<int32_t> *get_raw_data() { return this->data_; }
 
+  /// Unique number of the received burst this data belongs to, or 0 if unknown.
+  uint32_t get_burst() const { return this->burst_; }
+
  protected:
   int32_t lower_bound_(uint32_t length) { return int32_t(100 - this->tolerance_) * length / 100U; }
   int32_t upper_bound_(uint32_t length) { return int32_t(100 + this->tolerance_) * length / 100U; }
@@ -143,6 +147,7 @@ class RemoteReceiveData {
   uint32_t index_{0};
   std::vector<int32_t> *data_;
   uint8_t tolerance_;
+  uint32_t burst_;
 };
 
 template<typename T> class RemoteProtocol {
@@ -154,6 +159,31 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const T &data) = 0;
 };
 
+/** Decodes each received burst at most once per protocol.
+ *
+ * All binary sensors, triggers and dumpers of a protocol share the result for a burst, so a receiver with many codes
+ * of the same protocol only decodes the burst once instead of once per code. Failed decodes are cached as well, so a
+ * protocol that doesn't match the burst is rejected once.
+ */
+template<typename T, typename D> class RemoteDecodeCache {
+ public:
+  static optional<D> decode(RemoteReceiveData src) {
+    if (src.get_burst() == 0)
+      return T().decode(src);
+    if (src.get_burst() != burst_) {
+      result_ = T().decode(src);
+      burst_ = src.get_burst();
+    }
+    return result_;
+  }
+
+ protected:
+  static uint32_t burst_;
+  static optional<D> result_;
+};
+template<typename T, typename D> uint32_t RemoteDecodeCache<T, D>::burst_ = 0;
+template<typename T, typename D> optional<D> RemoteDecodeCache<T, D>::result_ = {};
+
 class RemoteComponentBase {
  public:
   explicit RemoteComponentBase(InternalGPIOPin *pin) : pin_(pin){};
@@ -246,7 +276,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   bool call_listeners_() {
     bool success = false;
     for (auto *listener : this->listeners_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->burst_);
       if (listener->on_receive(data))
         success = true;
     }
@@ -255,18 +285,22 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_dumpers_() {
     bool success = false;
     for (auto *dumper : this->dumpers_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->burst_);
       if (dumper->dump(data))
         success = true;
     }
     if (!success) {
       for (auto *dumper : this->secondary_dumpers_) {
-        auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+        auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->burst_);
         dumper->dump(data);
       }
     }
   }
   void call_listeners_dumpers_() {
+    // Each burst gets a number that's unique across all receivers, so decoded results can be shared
+    if (++next_burst_ == 0)
+      ++next_burst_;
+    this->burst_ = next_burst_;
     if (this->call_listeners_())
       return;
     // If a listener handled, then do not dump
@@ -278,6 +312,8 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   std::vector<int32_t> temp_;
   uint8_t tolerance_{25};
+  uint32_t burst_{0};
+  static uint32_t next_burst_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 };
 
 class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitiallyOff,
@@ -304,8 +340,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T, D>::decode(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -319,8 +354,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T, D>::decode(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -353,11 +387,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public Action<Ts...
 template<typename T, typename D> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = RemoteDecodeCache<T, D>::decode(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
@@ -18,6 +18,9 @@ static const uint16_t SCD4X_CMD_READ_MEASUREMENT = 0xec05;
 static const uint16_t SCD4X_CMD_PERFORM_FORCED_CALIBRATION = 0x362f;
 static const uint16_t SCD4X_CMD_STOP_MEASUREMENTS = 0x3f86;
 
+// Time the sensor needs before the response to a read command can be fetched
+static const uint32_t SCD4X_COMMAND_EXECUTION_TIME = 1;
+
 static const float SCD4X_TEMPERATURE_OFFSET_MULTIPLIER = (1 << 16) / 175.0f;
 
 void SCD4XComponent::setup() {
@@ -164,45 +167,37 @@ void SCD4XComponent::update() {
   }
 
   // Check if data is ready
-  if (!this->write_command_(SCD4X_CMD_GET_DATA_READY_STATUS)) {
-    this->status_set_warning();
-    return;
-  }
-
-  uint16_t raw_read_status[1];
-  if (!this->read_data_(raw_read_status, 1) || raw_read_status[0] == 0x00) {
-    this->status_set_warning();
-    ESP_LOGW(TAG, "Data not ready yet!");
-    return;
-  }
-
-  if (!this->write_command_(SCD4X_CMD_READ_MEASUREMENT)) {
-    ESP_LOGW(TAG, "Error reading measurement!");
-    this->status_set_warning();
-    return;
-  }
+  this->read_command_async_(SCD4X_CMD_GET_DATA_READY_STATUS, 1, [this](const uint16_t *raw_read_status) {
+    if (raw_read_status == nullptr || raw_read_status[0] == 0x00) {
+      this->status_set_warning();
+      ESP_LOGW(TAG, "Data not ready yet!");
+      return;
+    }
 
-  // Read off sensor data
-  uint16_t raw_data[3];
-  if (!this->read_data_(raw_data, 3)) {
-    this->status_set_warning();
-    return;
-  }
+    // Read off sensor data
+    this->read_command_async_(SCD4X_CMD_READ_MEASUREMENT, 3, [this](const uint16_t *raw_data) {
+      if (raw_data == nullptr) {
+        ESP_LOGW(TAG, "Error reading measurement!");
+        this->status_set_warning();
+        return;
+      }
 
-  if (this->co2_sensor_ != nullptr)
-    this->co2_sensor_->publish_state(raw_data[0]);
+      if (this->co2_sensor_ != nullptr)
+        this->co2_sensor_->publish_state(raw_data[0]);
 
-  if (this->temperature_sensor_ != nullptr) {
-    const float temperature = -45.0f + (175.0f * (raw_data[1])) / (1 << 16);
-    this->temperature_sensor_->publish_state(temperature);
-  }
+      if (this->temperature_sensor_ != nullptr) {
+        const float temperature = -45.0f + (175.0f * (raw_data[1])) / (1 << 16);
+        this->temperature_sensor_->publish_state(temperature);
+      }
 
-  if (this->humidity_sensor_ != nullptr) {
-    const float humidity = (100.0f * raw_data[2]) / (1 << 16);
-    this->humidity_sensor_->publish_state(humidity);
-  }
+      if (this->humidity_sensor_ != nullptr) {
+        const float humidity = (100.0f * raw_data[2]) / (1 << 16);
+        this->humidity_sensor_->publish_state(humidity);
+      }
 
-  this->status_clear_warning();
+      this->status_clear_warning();
+    });
+  });
 }
 // Note pressure in bar here. Convert to hPa
 void SCD4XComponent::set_ambient_pressure_compensation(float pressure_in_bar) {
@@ -259,7 +254,10 @@ bool SCD4XComponent::read_data_(uint16_t *data, uint8_t len) {
   if (this->read(buf.data(), num_bytes) != i2c::ERROR_OK) {
     return false;
   }
+  return this->parse_data_(buf.data(), data, len);
+}
 
+bool SCD4XComponent::parse_data_(const uint8_t *buf, uint16_t *data, uint8_t len) {
   for (uint8_t i = 0; i < len; i++) {
     const uint8_t j = 3 * i;
     uint8_t crc = sht_crc_(buf[j], buf[j + 1]);
@@ -272,6 +270,20 @@ bool SCD4XComponent::read_data_(uint16_t *data, uint8_t len) {
   return true;
 }
 
+void SCD4XComponent::read_command_async_(uint16_t command, uint8_t len,
+                                         std::function<void(const uint16_t *)> &&callback) {
+  const uint8_t raw[2] = {uint8_t(command >> 8), uint8_t(command & 0xFF)};
+  this->write_then_read_async(raw, 2, SCD4X_COMMAND_EXECUTION_TIME, this->response_, len * 3,
+                              [this, len, callback = std::move(callback)](i2c::ErrorCode err) {
+                                uint16_t data[3];
+                                if (err != i2c::ERROR_OK || !this->parse_data_(this->response_, data, len)) {
+                                  callback(nullptr);
+                                  return;
+                                }
+                                callback(data);
+                              });
+}
+
 bool SCD4XComponent::write_command_(uint16_t command) {
   const uint8_t num_bytes = 2;
   uint8_t buffer[num_bytes];
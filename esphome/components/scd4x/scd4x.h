@@ -29,6 +29,9 @@ class SCD4XComponent : public PollingComponent, public i2c::I2CDevice {
  protected:
   uint8_t sht_crc_(uint8_t data1, uint8_t data2);
   bool read_data_(uint16_t *data, uint8_t len);
+  bool parse_data_(const uint8_t *buf, uint16_t *data, uint8_t len);
+  /// Send \p command and read \p len words of its response without blocking, \p callback gets nullptr on errors.
+  void read_command_async_(uint16_t command, uint8_t len, std::function<void(const uint16_t *)> &&callback);
   bool write_command_(uint16_t command);
   bool write_command_(uint16_t command, uint16_t data);
   bool update_ambient_pressure_compensation_(uint16_t pressure_in_hpa);
@@ -48,6 +51,8 @@ class SCD4XComponent : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *humidity_sensor_{nullptr};
   // used for compensation
   sensor::Sensor *ambient_pressure_source_{nullptr};
+  /// Response of the last command sent with read_command_async_(), at most three words with their CRCs.
+  uint8_t response_[9];
 };
 
 }  // namespace scd4x
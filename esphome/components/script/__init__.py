@@ -78,7 +78,10 @@ async def to_code(config):
         triggers.append((trigger, conf))
 
     for trigger, conf in triggers:
-        await automation.build_automation(trigger, [], conf)
+        automation_ = await automation.build_automation(trigger, [], conf)
+        # Parallel runs may all be waiting at the same time
+        if conf[CONF_MODE] == CONF_PARALLEL and conf.get(CONF_MAX_RUNS, 0) > 0:
+            cg.add(automation_.reserve_runs(conf[CONF_MAX_RUNS]))
 
 
 @automation.register_action(
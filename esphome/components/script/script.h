@@ -117,18 +117,16 @@ template<typename... Ts> class ScriptWaitAction : public Action<Ts...>, public C
       this->play_next_(x...);
       return;
     }
-    this->var_ = std::make_tuple(x...);
-    this->loop();
+    this->runs_.add(0, x...);
   }
 
+  // A script doesn't report when it finishes, so the waiting runs check it every loop
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->runs_.empty() || this->script_->is_running())
       return;
 
-    if (this->script_->is_running())
-      return;
-
-    this->play_next_tuple_(this->var_);
+    this->runs_.resume([](const typename ActionRuns<Ts...>::Run &run, Ts... x) { return true; },
+                       [this](Ts... x) { this->play_next_(x...); });
   }
 
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -136,9 +134,12 @@ template<typename... Ts> class ScriptWaitAction : public Action<Ts...>, public C
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
+  void stop() override { this->runs_.clear(); }
+  void reserve_runs(size_t runs) override { this->runs_.reserve(runs); }
+
  protected:
   Script *script_;
-  std::tuple<Ts...> var_{};
+  ActionRuns<Ts...> runs_;
 };
 
 }  // namespace script
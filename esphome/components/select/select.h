@@ -57,7 +57,9 @@ class Select : public EntityBase {
   SelectCall make_call() { return SelectCall(this); }
   void set(const std::string &value) { make_call().set_option(value).perform(); }
 
-  void add_on_state_callback(std::function<void(std::string)> &&callback);
+  template<typename F> void add_on_state_callback(F &&callback) {
+    this->state_callback_.add(std::forward<F>(callback));
+  }
 
   SelectTraits traits;
 
@@ -21,9 +21,13 @@ class SHT3XDComponent : public PollingComponent, public i2c::I2CDevice {
  protected:
   bool write_command_(uint16_t command);
   bool read_data_(uint16_t *data, uint8_t len);
+  /// Check the CRC of each word in \p buf and store the words in \p data.
+  bool parse_data_(const uint8_t *buf, uint16_t *data, uint8_t len);
 
   sensor::Sensor *temperature_sensor_;
   sensor::Sensor *humidity_sensor_;
+  /// Raw measurement, filled by the bus while update() doesn't block.
+  uint8_t measurement_[6];
 };
 
 }  // namespace sht3xd
@@ -5,6 +5,7 @@
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
 #include <cstring>
+#include <sys/select.h>
 
 #ifdef USE_ESP32
 #include <esp_idf_version.h>
@@ -81,6 +82,16 @@ class BSDSocketImpl : public Socket {
   }
   int listen(int backlog) override { return ::listen(fd_, backlog); }
   ssize_t read(void *buf, size_t len) override { return ::read(fd_, buf, len); }
+  bool wait_readable(uint32_t timeout_ms) override {
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(fd_, &read_fds);
+    struct timeval tv;
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+    // errors also make the socket readable, so the following read reports them
+    return ::select(fd_ + 1, &read_fds, nullptr, nullptr, &tv) != 0;
+  }
   ssize_t readv(const struct iovec *iov, int iovcnt) override {
 #if defined(USE_ESP32) && ESP_IDF_VERSION_MAJOR < 4
     // esp-idf v3 doesn't have readv, emulate it
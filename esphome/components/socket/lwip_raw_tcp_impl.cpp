@@ -11,6 +11,7 @@
 #include <cstring>
 #include <queue>
 
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -364,6 +365,16 @@ class LWIPRawImpl : public Socket {
 
     return read;
   }
+  bool wait_readable(uint32_t timeout_ms) override {
+    // received data is queued by the callbacks, which only run while we yield
+    uint32_t start = millis();
+    while (pcb_ != nullptr && rx_buf_ == nullptr && !rx_closed_) {
+      if (millis() - start >= timeout_ms)
+        return false;
+      delay(1);
+    }
+    return true;
+  }
   ssize_t readv(const struct iovec *iov, int iovcnt) override {
     ssize_t ret = 0;
     for (int i = 0; i < iovcnt; i++) {
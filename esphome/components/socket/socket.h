@@ -36,6 +36,9 @@ class Socket {
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+  /// Wait until data can be read, the connection is closed or \p timeout_ms passed.
+  /// Returns false if the wait timed out.
+  virtual bool wait_readable(uint32_t timeout_ms) = 0;
 };
 
 /// Create a socket of the given domain, type and protocol.
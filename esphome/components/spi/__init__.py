@@ -70,6 +70,9 @@ def spi_device_schema(cs_pin_required=True):
 async def register_spi_device(var, config):
     parent = await cg.get_variable(config[CONF_SPI_ID])
     cg.add(var.set_spi_parent(parent))
+    if CONF_ID in config and config[CONF_ID].type.inherits_from(cg.PollingComponent):
+        # Keep the updates of the devices on one bus apart
+        cg.add(var.set_update_group(parent))
     if CONF_CS_PIN in config:
         pin = await cg.gpio_pin_expression(config[CONF_CS_PIN])
         cg.add(var.set_cs_pin(pin))
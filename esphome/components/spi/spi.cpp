@@ -3,6 +3,14 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+#include <esp_heap_caps.h>
+#include <soc/soc_caps.h>
+#include <soc/soc_memory_layout.h>
+#include <algorithm>
+#include <cstring>
+#endif
+
 namespace esphome {
 namespace spi {
 
@@ -14,6 +22,9 @@ void IRAM_ATTR HOT SPIComponent::disable() {
     this->hw_spi_->endTransaction();
   }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  this->wait_for_writes();
+#endif  // USE_SPI_ESP_IDF_BACKEND
   if (this->active_cs_) {
     this->active_cs_->digital_write(true);
     this->active_cs_ = nullptr;
@@ -24,7 +35,7 @@ void SPIComponent::setup() {
   this->clk_->setup();
   this->clk_->digital_write(true);
 
-#ifdef USE_SPI_ARDUINO_BACKEND
+#if defined(USE_SPI_ARDUINO_BACKEND) || defined(USE_SPI_ESP_IDF_BACKEND)
   bool use_hw_spi = true;
   const bool has_miso = this->miso_ != nullptr;
   const bool has_mosi = this->mosi_ != nullptr;
@@ -66,6 +77,35 @@ void SPIComponent::setup() {
     return;
   }
 #endif  // USE_ESP8266
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  // SPI1 is used for the flash
+  static uint8_t next_host = SPI2_HOST;
+  if (next_host >= SOC_SPI_PERIPH_NUM)
+    use_hw_spi = false;
+
+  if (use_hw_spi) {
+    this->host_ = static_cast<spi_host_device_t>(next_host);
+    spi_bus_config_t bus_config{};
+    bus_config.sclk_io_num = clk_pin;
+    bus_config.miso_io_num = miso_pin;
+    bus_config.mosi_io_num = mosi_pin;
+    bus_config.quadwp_io_num = -1;
+    bus_config.quadhd_io_num = -1;
+    bus_config.max_transfer_sz = SPI_MAX_TRANSFER_SIZE;
+    esp_err_t err = spi_bus_initialize(this->host_, &bus_config, SPI_DMA_CH_AUTO);
+    if (err == ESP_OK) {
+      this->bounce_buffers_ = static_cast<uint8_t *>(heap_caps_malloc(2 * SPI_BOUNCE_BUFFER_SIZE, MALLOC_CAP_DMA));
+      if (this->bounce_buffers_ != nullptr) {
+        next_host++;
+        this->hw_bus_ = true;
+        return;
+      }
+      spi_bus_free(this->host_);
+    }
+    ESP_LOGW(TAG, "Could not set up the SPI peripheral, using software SPI: %s", esp_err_to_name(err));
+  }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+#ifdef USE_SPI_ARDUINO_BACKEND
 #ifdef USE_ESP32
   static uint8_t spi_bus_num = 0;
   if (spi_bus_num >= 2) {
@@ -84,6 +124,7 @@ void SPIComponent::setup() {
   }
 #endif  // USE_ESP32
 #endif  // USE_SPI_ARDUINO_BACKEND
+#endif  // USE_SPI_ARDUINO_BACKEND || USE_SPI_ESP_IDF_BACKEND
 
   if (this->miso_ != nullptr) {
     this->miso_->setup();
@@ -101,9 +142,182 @@ void SPIComponent::dump_config() {
 #ifdef USE_SPI_ARDUINO_BACKEND
   ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->hw_spi_ != nullptr));
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->hw_bus_));
+#endif  // USE_SPI_ESP_IDF_BACKEND
 }
 float SPIComponent::get_setup_priority() const { return setup_priority::BUS; }
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+void SPIComponent::wait_for_writes() {
+  while (this->queued_ > 0)
+    this->hw_wait_one_();
+}
+
+bool SPIComponent::is_writing() {
+  spi_transaction_t *transaction;
+  while (this->queued_ > 0 && spi_device_get_trans_result(this->hw_device_, &transaction, 0) == ESP_OK)
+    this->queued_--;
+  return this->queued_ > 0;
+}
+
+void SPIComponent::hw_enable_(SPIBitOrder bit_order, SPIClockPolarity clock_polarity, SPIClockPhase clock_phase,
+                              uint32_t data_rate) {
+  this->wait_for_writes();
+  uint8_t mode = (clock_polarity ? 2 : 0) | (clock_phase == CLOCK_PHASE_TRAILING ? 1 : 0);
+  bool lsb_first = bit_order == BIT_ORDER_LSB_FIRST;
+  for (auto &device : this->hw_devices_) {
+    if (device.handle != nullptr && device.data_rate == data_rate && device.mode == mode &&
+        device.lsb_first == lsb_first) {
+      this->hw_device_ = device.handle;
+      return;
+    }
+  }
+
+  // Replace the configurations in turn once the bus is full
+  HWDevice &device = this->hw_devices_[this->next_hw_device_];
+  this->next_hw_device_ = (this->next_hw_device_ + 1) % SPI_MAX_DEVICES;
+  if (device.handle != nullptr)
+    spi_bus_remove_device(device.handle);
+
+  spi_device_interface_config_t config{};
+  config.mode = mode;
+  config.clock_speed_hz = data_rate;
+  // The chip select pins are driven by the components
+  config.spics_io_num = -1;
+  config.queue_size = SPI_QUEUE_SIZE;
+  // Like the Arduino backend, allow reading at clocks the GPIO matrix may be too slow for
+  config.flags = SPI_DEVICE_NO_DUMMY;
+  if (lsb_first)
+    config.flags |= SPI_DEVICE_TXBIT_LSBFIRST | SPI_DEVICE_RXBIT_LSBFIRST;
+  esp_err_t err = spi_bus_add_device(this->host_, &config, &device.handle);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Adding SPI device failed: %s", esp_err_to_name(err));
+    device.handle = nullptr;
+  }
+  device.data_rate = data_rate;
+  device.mode = mode;
+  device.lsb_first = lsb_first;
+  this->hw_device_ = device.handle;
+}
+
+void SPIComponent::hw_queue_(spi_transaction_t *transaction) {
+  if (spi_device_queue_trans(this->hw_device_, transaction, portMAX_DELAY) == ESP_OK)
+    this->queued_++;
+}
+
+void SPIComponent::hw_wait_one_() {
+  spi_transaction_t *transaction;
+  spi_device_get_trans_result(this->hw_device_, &transaction, portMAX_DELAY);
+  this->queued_--;
+}
+
+void SPIComponent::hw_transfer_(const uint8_t *tx, uint8_t *rx, size_t length) {
+  if (this->hw_device_ == nullptr || length == 0)
+    return;
+  this->wait_for_writes();
+
+  spi_transaction_t *transaction = &this->transactions_[0];
+  if (length <= 4) {
+    // Short transfers go through the registers of the transaction, without DMA
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+    transaction->length = length * 8;
+    if (tx != nullptr)
+      memcpy(transaction->tx_data, tx, length);
+    spi_device_polling_transmit(this->hw_device_, transaction);
+    if (rx != nullptr)
+      memcpy(rx, transaction->rx_data, length);
+    return;
+  }
+
+  if (rx != nullptr) {
+    // Reads are rare and short, send and receive through one buffer each
+    uint8_t *tx_buffer = this->bounce_buffers_;
+    uint8_t *rx_buffer = this->bounce_buffers_ + SPI_BOUNCE_BUFFER_SIZE;
+    for (size_t pos = 0; pos < length; pos += SPI_BOUNCE_BUFFER_SIZE) {
+      size_t chunk = std::min(length - pos, SPI_BOUNCE_BUFFER_SIZE);
+      if (tx != nullptr) {
+        memcpy(tx_buffer, tx + pos, chunk);
+      } else {
+        memset(tx_buffer, 0, chunk);
+      }
+      memset(transaction, 0, sizeof(spi_transaction_t));
+      transaction->length = chunk * 8;
+      transaction->tx_buffer = tx_buffer;
+      transaction->rx_buffer = rx_buffer;
+      spi_device_polling_transmit(this->hw_device_, transaction);
+      memcpy(rx + pos, rx_buffer, chunk);
+    }
+    return;
+  }
+
+  // Fill one buffer while the other one is sent
+  uint8_t index = 0;
+  for (size_t pos = 0; pos < length; pos += SPI_BOUNCE_BUFFER_SIZE) {
+    size_t chunk = std::min(length - pos, SPI_BOUNCE_BUFFER_SIZE);
+    uint8_t *buffer = this->bounce_buffers_ + index * SPI_BOUNCE_BUFFER_SIZE;
+    memcpy(buffer, tx + pos, chunk);
+    transaction = &this->transactions_[index];
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->length = chunk * 8;
+    transaction->tx_buffer = buffer;
+    this->hw_queue_(transaction);
+    if (this->queued_ == 2)
+      this->hw_wait_one_();
+    index ^= 1;
+  }
+  this->wait_for_writes();
+}
+
+void SPIComponent::hw_write16_(const uint16_t *data, size_t length) {
+  if (this->hw_device_ == nullptr)
+    return;
+  this->wait_for_writes();
+  uint8_t index = 0;
+  const size_t words = SPI_BOUNCE_BUFFER_SIZE / 2;
+  for (size_t pos = 0; pos < length; pos += words) {
+    size_t chunk = std::min(length - pos, words);
+    uint8_t *buffer = this->bounce_buffers_ + index * SPI_BOUNCE_BUFFER_SIZE;
+    for (size_t i = 0; i < chunk; i++) {
+      buffer[2 * i] = data[pos + i] >> 8;
+      buffer[2 * i + 1] = data[pos + i];
+    }
+    spi_transaction_t *transaction = &this->transactions_[index];
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->length = chunk * 16;
+    transaction->tx_buffer = buffer;
+    this->hw_queue_(transaction);
+    if (this->queued_ == 2)
+      this->hw_wait_one_();
+    index ^= 1;
+  }
+  this->wait_for_writes();
+}
+
+void SPIComponent::hw_write_async_(const uint8_t *data, size_t length) {
+  // DMA can only read word aligned internal memory, anything else is copied while waiting
+  if (this->hw_device_ == nullptr || !esp_ptr_dma_capable(data) || reinterpret_cast<uintptr_t>(data) % 4 != 0) {
+    this->hw_transfer_(data, nullptr, length);
+    return;
+  }
+  for (size_t pos = 0; pos < length; pos += SPI_MAX_TRANSFER_SIZE) {
+    // The transactions complete in order, so the oldest one frees the next slot
+    if (this->queued_ == SPI_QUEUE_SIZE)
+      this->hw_wait_one_();
+    spi_transaction_t *transaction = &this->transactions_[this->next_transaction_];
+    this->next_transaction_ = (this->next_transaction_ + 1) % SPI_QUEUE_SIZE;
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->length = std::min(length - pos, SPI_MAX_TRANSFER_SIZE) * 8;
+    transaction->tx_buffer = data + pos;
+    this->hw_queue_(transaction);
+  }
+}
+#else
+void SPIComponent::wait_for_writes() {}
+bool SPIComponent::is_writing() { return false; }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 void SPIComponent::cycle_clock_(bool value) {
   uint32_t start = arch_get_cpu_cycle_count();
   while (start - arch_get_cpu_cycle_count() < this->wait_cycle_)
@@ -8,10 +8,18 @@
 #define USE_SPI_ARDUINO_BACKEND
 #endif
 
+#ifdef USE_ESP_IDF
+#define USE_SPI_ESP_IDF_BACKEND
+#endif
+
 #ifdef USE_SPI_ARDUINO_BACKEND
 #include <SPI.h>
 #endif
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+#include <driver/spi_master.h>
+#endif
+
 namespace esphome {
 namespace spi {
 
@@ -69,6 +77,17 @@ enum SPIDataRate : uint32_t {
   DATA_RATE_40MHZ = 40000000,
 };
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+/// Longest transaction queued for DMA, longer writes are split.
+static const size_t SPI_MAX_TRANSFER_SIZE = 32768;
+/// Transactions that can be queued on the bus at once.
+static const uint8_t SPI_QUEUE_SIZE = 8;
+/// Device configurations (clock and mode) kept on the bus, the driver allows as many as there are CS lines.
+static const uint8_t SPI_MAX_DEVICES = 3;
+/// Size of each of the two DMA capable buffers that data from other memory is copied through.
+static const size_t SPI_BOUNCE_BUFFER_SIZE = 2048;
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 class SPIComponent : public Component {
  public:
   void set_clk(GPIOPin *clk) { clk_ = clk; }
@@ -85,6 +104,13 @@ class SPIComponent : public Component {
       return this->hw_spi_->transfer(0x00);
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      uint8_t data;
+      this->hw_transfer_(nullptr, &data, 1);
+      return data;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     return this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, false>(0x00);
   }
 
@@ -96,6 +122,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_transfer_(nullptr, data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       data[i] = this->read_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>();
     }
@@ -109,6 +141,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_transfer_(&data, nullptr, 1);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, false, true>(data);
   }
 
@@ -120,6 +158,13 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      uint8_t bytes[2] = {uint8_t(data >> 8), uint8_t(data)};
+      this->hw_transfer_(bytes, nullptr, 2);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data >> 8);
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
@@ -135,6 +180,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_write16_(data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       this->write_byte16<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
     }
@@ -149,11 +200,38 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_transfer_(data, nullptr, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
     }
   }
 
+  /** Start writing \p data and return, if the bus can write it with DMA. Otherwise it's written right away.
+   *
+   * \p data has to stay unchanged until the writes are done, see wait_for_writes(). disable() waits as well, so the
+   * device can keep the bus until is_writing() returns false.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void write_array_async(const uint8_t *data, size_t length) {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_write_async_(data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+    this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  /// Wait until all writes started with write_array_async() are done.
+  void wait_for_writes();
+  /// Whether writes started with write_array_async() are still running.
+  bool is_writing();
+
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
   uint8_t transfer_byte(uint8_t data) {
 #ifdef USE_SPI_ARDUINO_BACKEND
@@ -165,6 +243,12 @@ class SPIComponent : public Component {
       }
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_ && this->miso_ != nullptr) {
+      this->hw_transfer_(&data, &data, 1);
+      return data;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
     return 0;
   }
@@ -181,6 +265,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      this->hw_transfer_(data, this->miso_ != nullptr ? data : nullptr, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     if (this->miso_ != nullptr) {
       for (size_t i = 0; i < length; i++) {
@@ -207,9 +297,20 @@ class SPIComponent : public Component {
       this->hw_spi_->beginTransaction(settings);
     } else {
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->hw_bus_) {
+      // A device that wrote asynchronously may still hold the bus
+      if (this->active_cs_ != nullptr && this->active_cs_ != cs)
+        this->disable();
+      this->hw_enable_(BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE);
+    } else {
+#endif  // USE_SPI_ESP_IDF_BACKEND
       this->clk_->digital_write(CLOCK_POLARITY);
       uint32_t cpu_freq_hz = arch_get_cpu_freq_hz();
       this->wait_cycle_ = uint32_t(cpu_freq_hz) / DATA_RATE / 2ULL;
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 #ifdef USE_SPI_ARDUINO_BACKEND
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
@@ -237,6 +338,36 @@ class SPIComponent : public Component {
 #ifdef USE_SPI_ARDUINO_BACKEND
   SPIClass *hw_spi_{nullptr};
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  struct HWDevice {
+    spi_device_handle_t handle{nullptr};
+    uint32_t data_rate;
+    uint8_t mode;
+    bool lsb_first;
+  };
+
+  /// Select the device configuration for the next transfers, adding it to the bus if needed.
+  void hw_enable_(SPIBitOrder bit_order, SPIClockPolarity clock_polarity, SPIClockPhase clock_phase,
+                  uint32_t data_rate);
+  /// Full duplex transfer, \p tx or \p rx may be nullptr. Waits until it's done.
+  void hw_transfer_(const uint8_t *tx, uint8_t *rx, size_t length);
+  void hw_write16_(const uint16_t *data, size_t length);
+  void hw_write_async_(const uint8_t *data, size_t length);
+  void hw_queue_(spi_transaction_t *transaction);
+  /// Wait for the oldest queued transaction.
+  void hw_wait_one_();
+
+  bool hw_bus_{false};
+  spi_host_device_t host_;
+  HWDevice hw_devices_[SPI_MAX_DEVICES];
+  uint8_t next_hw_device_{0};
+  spi_device_handle_t hw_device_{nullptr};
+  /// Two DMA capable buffers of SPI_BOUNCE_BUFFER_SIZE bytes.
+  uint8_t *bounce_buffers_{nullptr};
+  spi_transaction_t transactions_[SPI_QUEUE_SIZE];
+  uint8_t next_transaction_{0};
+  uint8_t queued_{0};
+#endif  // USE_SPI_ESP_IDF_BACKEND
   uint32_t wait_cycle_;
 };
 
@@ -292,6 +423,14 @@ class SPIDevice {
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
+  void write_array_async(const uint8_t *data, size_t length) {
+    this->parent_->template write_array_async<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  void wait_for_writes() { this->parent_->wait_for_writes(); }
+
+  bool is_writing() { return this->parent_->is_writing(); }
+
   uint8_t transfer_byte(uint8_t data) {
     return this->parent_->template transfer_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
   }
@@ -127,11 +127,21 @@ void ST7789V::dump_config() {
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
+  // Don't draw into the buffer while the previous frame is written from it
+  if (this->writing_frame_) {
+    this->disable();
+    this->writing_frame_ = false;
+  }
   this->do_update_();
   this->write_display_data();
 }
 
-void ST7789V::loop() {}
+void ST7789V::loop() {
+  if (this->writing_frame_ && !this->is_writing()) {
+    this->disable();
+    this->writing_frame_ = false;
+  }
+}
 
 void ST7789V::write_display_data() {
   uint16_t x1 = 52;   // _offsetx
@@ -156,9 +166,13 @@ void ST7789V::write_display_data() {
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  this->write_array(this->buffer_, this->get_buffer_length_());
+  this->write_array_async(this->buffer_, this->get_buffer_length_());
 
-  this->disable();
+  if (this->is_writing()) {
+    this->writing_frame_ = true;
+  } else {
+    this->disable();
+  }
 }
 
 void ST7789V::init_reset_() {
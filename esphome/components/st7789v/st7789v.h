@@ -130,6 +130,8 @@ class ST7789V : public PollingComponent,
   GPIOPin *dc_pin_;
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *backlight_pin_{nullptr};
+  /// The frame is still being written from the buffer, the bus is released in loop() once that's done.
+  bool writing_frame_{false};
 
   void init_reset_();
   void backlight_(bool onoff);
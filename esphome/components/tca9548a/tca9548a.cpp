@@ -18,6 +18,36 @@ i2c::ErrorCode TCA9548AChannel::writev(uint8_t address, i2c::WriteBuffer *buffer
     return err;
   return parent_->bus_->writev(address, buffers, cnt);
 }
+void TCA9548AChannel::submit(i2c::Transaction &&transaction) {
+  if (this->parent_->is_failed()) {
+    transaction.callback(i2c::ERROR_NOT_INITIALIZED);
+    return;
+  }
+  this->pending_.push_back(std::move(transaction));
+  this->parent_->queued_[this->channel_] = this;
+  this->parent_->queued_mask_ |= 1 << this->channel_;
+}
+size_t TCA9548AChannel::run_pending_() {
+  // Callbacks may submit again, those transactions wait for the next visit
+  std::vector<i2c::Transaction> pending;
+  pending.swap(this->pending_);
+  for (auto &transaction : pending) {
+    i2c::ErrorCode err = this->run_write_(transaction);
+    if (err == i2c::ERROR_OK && transaction.read_len != 0) {
+      if (transaction.delay_ms != 0) {
+        // Come back for the read, together with whatever else is queued for this channel by then
+        uint32_t delay_ms = transaction.delay_ms;
+        transaction.write_len = 0;
+        transaction.delay_ms = 0;
+        this->parent_->set_timeout(delay_ms, [this, transaction]() mutable { this->submit(std::move(transaction)); });
+        continue;
+      }
+      err = this->run_read_(transaction);
+    }
+    transaction.callback(err);
+  }
+  return pending.size();
+}
 
 void TCA9548AComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up TCA9548A...");
@@ -29,6 +59,19 @@ void TCA9548AComponent::setup() {
   }
   ESP_LOGD(TAG, "Channels currently open: %d", status);
 }
+void TCA9548AComponent::loop() {
+  if (this->queued_mask_ == 0)
+    return;
+  uint8_t first = this->current_channel_ < 8 ? this->current_channel_ : 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    uint8_t channel = (first + i) % 8;
+    if ((this->queued_mask_ & (1 << channel)) == 0)
+      continue;
+    this->queued_mask_ &= ~(1 << channel);
+    this->transactions_ += this->queued_[channel]->run_pending_();
+  }
+  ESP_LOGVV(TAG, "%u channel switches for %u transactions so far", this->channel_switches_, this->transactions_);
+}
 void TCA9548AComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "TCA9548A:");
   LOG_I2C_DEVICE(this);
@@ -40,10 +83,12 @@ i2c::ErrorCode TCA9548AComponent::switch_to_channel(uint8_t channel) {
   if (current_channel_ == channel)
     return i2c::ERROR_OK;
 
+  // The control register is the only one, so it's written without a register address
   uint8_t channel_val = 1 << channel;
-  auto err = this->write_register(0x70, &channel_val, 1);
+  auto err = this->write(&channel_val, 1);
   if (err == i2c::ERROR_OK) {
     current_channel_ = channel;
+    this->channel_switches_++;
   }
   return err;
 }
@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/i2c/i2c.h"
+#include <vector>
 
 namespace esphome {
 namespace tca9548a {
@@ -14,24 +15,49 @@ class TCA9548AChannel : public i2c::I2CBus {
 
   i2c::ErrorCode readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) override;
   i2c::ErrorCode writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt) override;
+  /// Queue \p transaction until the multiplexer gets to this channel, see TCA9548AComponent::loop().
+  void submit(i2c::Transaction &&transaction) override;
 
  protected:
+  friend class TCA9548AComponent;
+
+  /// Run the queued transactions, returns how many there were.
+  size_t run_pending_();
+
   uint8_t channel_;
   TCA9548AComponent *parent_;
+  std::vector<i2c::Transaction> pending_;
 };
 
+/** TCA9548A I2C multiplexer.
+ *
+ * Blocking transfers switch to their channel right away. Submitted transactions are collected per channel and run
+ * from loop(), which visits each channel with work once, starting with the one that's selected. Devices that update
+ * at the same time then share one switch per channel.
+ */
 class TCA9548AComponent : public Component, public i2c::I2CDevice {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::IO; }
   void update();
 
   i2c::ErrorCode switch_to_channel(uint8_t channel);
 
+  /// Number of times the selected channel was changed, for diagnostics.
+  uint32_t get_channel_switches() const { return this->channel_switches_; }
+  /// Number of submitted transactions that were run, for diagnostics.
+  uint32_t get_transactions() const { return this->transactions_; }
+
  protected:
   friend class TCA9548AChannel;
   uint8_t current_channel_ = 255;
+  /// Channels with queued transactions, indexed by channel number.
+  TCA9548AChannel *queued_[8]{};
+  uint8_t queued_mask_{0};
+  uint32_t channel_switches_{0};
+  uint32_t transactions_{0};
 };
 }  // namespace tca9548a
 }  // namespace esphome
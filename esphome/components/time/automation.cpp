@@ -1,12 +1,26 @@
 #include "automation.h"
 #include "esphome/core/log.h"
-#include <cinttypes>
+#include <algorithm>
 
 namespace esphome {
 namespace time {
 
 static const char *const TAG = "automation";
 
+/// Time jumps larger than this skip the matches in between instead of firing them all.
+static const time_t MAX_TIME_JUMP = 900;
+/// Check the time at least this often, the clock may have been adjusted without a sync callback.
+static const time_t MAX_CHECK_INTERVAL = 60;
+/// Give up looking for a match after this many years (Feb 29 on a Monday repeats every 28 years).
+static const uint16_t MAX_SEARCH_YEARS = 28;
+
+/// Index of the first set bit in [from, end) of \p bits, or end if there is none.
+template<size_t N> static uint8_t next_set_bit(const std::bitset<N> &bits, uint8_t from, uint8_t end) {
+  while (from < end && !bits[from])
+    from++;
+  return from;
+}
+
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
 void CronTrigger::add_hour(uint8_t hour) { this->hours_[hour] = true; }
@@ -17,40 +31,99 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
+void CronTrigger::setup() {
+  // The time zone is set up by the clock, which may happen after this
+  this->defer([this]() { this->check_time_(); });
+  this->rtc_->add_on_time_sync_callback([this]() { this->check_time_(); });
+}
+void CronTrigger::check_time_() {
+  time_t now = this->rtc_->timestamp_now();
+  if (!this->rtc_->now().is_valid())
+    return;  // the sync callback calls us once there is a valid time
 
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > 900) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
+  if (this->last_check_ == 0) {
+    this->last_check_ = now - 1;
+  } else if (this->last_check_ - now > MAX_TIME_JUMP) {
+    // We went back in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped back!");
+    this->last_check_ = now - 1;
+  } else if (now - this->last_check_ > MAX_TIME_JUMP) {
+    ESP_LOGW(TAG, "Time has jumped forward!");
+    this->last_check_ = now - 1;
+  }
+
+  ESPTime next = ESPTime::from_epoch_local(this->last_check_);
+  while (true) {
+    if (!this->next_match_(next)) {
+      ESP_LOGW(TAG, "Time trigger never matches!");
+      this->last_check_ = std::max(this->last_check_, now);
       return;
     }
-
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    struct tm c_tm = next.to_c_tm();
+    c_tm.tm_isdst = -1;  // let mktime figure out DST, the fields were advanced without it
+    time_t next_timestamp = ::mktime(&c_tm);
+    if (next_timestamp > now) {
+      time_t delay = std::min(next_timestamp - now, MAX_CHECK_INTERVAL);
+      this->set_timeout("check", delay * 1000, [this]() { this->check_time_(); });
+      break;
+    }
+    // Matches that are due, also the ones we skipped because the time was set forward a bit
+    if (next_timestamp > this->last_check_) {
+      this->trigger();
+      this->last_check_ = next_timestamp;
     }
   }
-
-  this->last_check_ = time;
-  if (!time.fields_in_range()) {
-    ESP_LOGW(TAG, "Time is out of range!");
-    ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
-             time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year, time.month,
-             (int64_t) time.timestamp);
+  this->last_check_ = std::max(this->last_check_, now);
+}
+bool CronTrigger::next_match_(ESPTime &time) {
+  uint16_t max_year = time.year + MAX_SEARCH_YEARS;
+  time.increment_second();
+  while (time.year <= max_year) {
+    if (!this->months_[time.month] || !this->days_of_month_[time.day_of_month] ||
+        !this->days_of_week_[time.day_of_week]) {
+      // continue with the next day
+      time.hour = 23;
+      time.minute = 59;
+      time.second = 59;
+      time.increment_second();
+      continue;
+    }
+    uint8_t hour = next_set_bit(this->hours_, time.hour, 24);
+    if (hour == 24) {
+      time.hour = 23;
+      time.minute = 59;
+      time.second = 59;
+      time.increment_second();
+      continue;
+    }
+    if (hour != time.hour) {
+      time.hour = hour;
+      time.minute = 0;
+      time.second = 0;
+    }
+    uint8_t minute = next_set_bit(this->minutes_, time.minute, 60);
+    if (minute == 60) {
+      // continue with the next hour
+      time.minute = 59;
+      time.second = 59;
+      time.increment_second();
+      continue;
+    }
+    if (minute != time.minute) {
+      time.minute = minute;
+      time.second = 0;
+    }
+    uint8_t second = next_set_bit(this->seconds_, time.second, 60);
+    if (second == 60) {
+      // continue with the next minute
+      time.second = 59;
+      time.increment_second();
+      continue;
+    }
+    time.second = second;
+    return true;
   }
-
-  if (this->matches(time))
-    this->trigger();
+  return false;
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
@@ -23,10 +23,15 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+  void setup() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Fire for all matches since the last check, and schedule the next check at the next match.
+  void check_time_();
+  /// Advance \p time to the next time after it that matches, returns false if there is none.
+  bool next_match_(ESPTime &time);
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -34,7 +39,8 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+  /// Timestamp up to which all matches have been handled, 0 if the time wasn't valid yet.
+  time_t last_check_{0};
 };
 
 class SyncTrigger : public Trigger<>, public Component {
@@ -4,6 +4,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/util.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace tuya {
 
@@ -203,9 +205,11 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
       break;
     case TuyaCommandType::DATAPOINT_QUERY:
       break;
-    case TuyaCommandType::WIFI_TEST:
-      this->send_command_(TuyaCommand{.cmd = TuyaCommandType::WIFI_TEST, .payload = std::vector<uint8_t>{0x00, 0x00}});
+    case TuyaCommandType::WIFI_TEST: {
+      const uint8_t payload[] = {0x00, 0x00};
+      this->send_command_(TuyaCommandType::WIFI_TEST, payload, sizeof(payload));
       break;
+    }
     case TuyaCommandType::LOCAL_TIME_QUERY:
 #ifdef USE_TIME
       if (this->time_id_.has_value()) {
@@ -226,73 +230,47 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
 
 void Tuya::handle_datapoints_(const uint8_t *buffer, size_t len) {
   while (len >= 4) {
-    TuyaDatapoint datapoint{};
-    datapoint.id = buffer[0];
-    datapoint.type = (TuyaDatapointType) buffer[1];
-    datapoint.value_uint = 0;
-
+    uint8_t id = buffer[0];
+    auto type = (TuyaDatapointType) buffer[1];
     size_t data_size = (buffer[2] << 8) + buffer[3];
     const uint8_t *data = buffer + 4;
     size_t data_len = len - 4;
     if (data_size > data_len) {
-      ESP_LOGW(TAG, "Datapoint %u is truncated and cannot be parsed (%zu > %zu)", datapoint.id, data_size, data_len);
+      ESP_LOGW(TAG, "Datapoint %u is truncated and cannot be parsed (%zu > %zu)", id, data_size, data_len);
       return;
     }
 
-    datapoint.len = data_size;
-
-    switch (datapoint.type) {
+    // validate before touching the stored datapoint, it's updated in place
+    switch (type) {
       case TuyaDatapointType::RAW:
-        datapoint.value_raw = std::vector<uint8_t>(data, data + data_size);
-        ESP_LOGD(TAG, "Datapoint %u update to %s", datapoint.id, format_hex_pretty(datapoint.value_raw).c_str());
+      case TuyaDatapointType::STRING:
         break;
       case TuyaDatapointType::BOOLEAN:
         if (data_size != 1) {
-          ESP_LOGW(TAG, "Datapoint %u has bad boolean len %zu", datapoint.id, data_size);
+          ESP_LOGW(TAG, "Datapoint %u has bad boolean len %zu", id, data_size);
           return;
         }
-        datapoint.value_bool = data[0];
-        ESP_LOGD(TAG, "Datapoint %u update to %s", datapoint.id, ONOFF(datapoint.value_bool));
         break;
       case TuyaDatapointType::INTEGER:
         if (data_size != 4) {
-          ESP_LOGW(TAG, "Datapoint %u has bad integer len %zu", datapoint.id, data_size);
+          ESP_LOGW(TAG, "Datapoint %u has bad integer len %zu", id, data_size);
           return;
         }
-        datapoint.value_uint = encode_uint32(data[0], data[1], data[2], data[3]);
-        ESP_LOGD(TAG, "Datapoint %u update to %d", datapoint.id, datapoint.value_int);
-        break;
-      case TuyaDatapointType::STRING:
-        datapoint.value_string = std::string(reinterpret_cast<const char *>(data), data_size);
-        ESP_LOGD(TAG, "Datapoint %u update to %s", datapoint.id, datapoint.value_string.c_str());
         break;
       case TuyaDatapointType::ENUM:
         if (data_size != 1) {
-          ESP_LOGW(TAG, "Datapoint %u has bad enum len %zu", datapoint.id, data_size);
+          ESP_LOGW(TAG, "Datapoint %u has bad enum len %zu", id, data_size);
           return;
         }
-        datapoint.value_enum = data[0];
-        ESP_LOGD(TAG, "Datapoint %u update to %d", datapoint.id, datapoint.value_enum);
         break;
       case TuyaDatapointType::BITMASK:
-        switch (data_size) {
-          case 1:
-            datapoint.value_bitmask = encode_uint32(0, 0, 0, data[0]);
-            break;
-          case 2:
-            datapoint.value_bitmask = encode_uint32(0, 0, data[0], data[1]);
-            break;
-          case 4:
-            datapoint.value_bitmask = encode_uint32(data[0], data[1], data[2], data[3]);
-            break;
-          default:
-            ESP_LOGW(TAG, "Datapoint %u has bad bitmask len %zu", datapoint.id, data_size);
-            return;
+        if (data_size != 1 && data_size != 2 && data_size != 4) {
+          ESP_LOGW(TAG, "Datapoint %u has bad bitmask len %zu", id, data_size);
+          return;
         }
-        ESP_LOGD(TAG, "Datapoint %u update to %#08X", datapoint.id, datapoint.value_bitmask);
         break;
       default:
-        ESP_LOGW(TAG, "Datapoint %u has unknown type %#02hhX", datapoint.id, static_cast<uint8_t>(datapoint.type));
+        ESP_LOGW(TAG, "Datapoint %u has unknown type %#02hhX", id, static_cast<uint8_t>(type));
         return;
     }
 
@@ -302,8 +280,8 @@ void Tuya::handle_datapoints_(const uint8_t *buffer, size_t len) {
     // drop update if datapoint is in ignore_mcu_datapoint_update list
     bool skip = false;
     for (auto i : this->ignore_mcu_update_on_datapoints_) {
-      if (datapoint.id == i) {
-        ESP_LOGV(TAG, "Datapoint %u found in ignore_mcu_update_on_datapoints list, dropping MCU update", datapoint.id);
+      if (id == i) {
+        ESP_LOGV(TAG, "Datapoint %u found in ignore_mcu_update_on_datapoints list, dropping MCU update", id);
         skip = true;
         break;
       }
@@ -311,29 +289,71 @@ void Tuya::handle_datapoints_(const uint8_t *buffer, size_t len) {
     if (skip)
       continue;
 
-    // Update internal datapoints
-    bool found = false;
-    for (auto &other : this->datapoints_) {
-      if (other.id == datapoint.id) {
-        other = datapoint;
-        found = true;
-      }
+    // Update the internal datapoint in place, this reuses the storage of raw and string values
+    TuyaDatapoint *datapoint = this->get_datapoint_(id);
+    if (datapoint == nullptr) {
+      this->datapoints_.push_back(TuyaDatapoint{});
+      datapoint = &this->datapoints_.back();
+      datapoint->id = id;
+    } else if (datapoint->type != type) {
+      datapoint->value_raw.clear();
+      datapoint->value_string.clear();
     }
-    if (!found) {
-      this->datapoints_.push_back(datapoint);
+    datapoint->type = type;
+    datapoint->len = data_size;
+    datapoint->value_uint = 0;
+
+    switch (type) {
+      case TuyaDatapointType::RAW:
+        datapoint->value_raw.assign(data, data + data_size);
+        ESP_LOGD(TAG, "Datapoint %u update to %s", id, format_hex_pretty(datapoint->value_raw).c_str());
+        break;
+      case TuyaDatapointType::BOOLEAN:
+        datapoint->value_bool = data[0];
+        ESP_LOGD(TAG, "Datapoint %u update to %s", id, ONOFF(datapoint->value_bool));
+        break;
+      case TuyaDatapointType::INTEGER:
+        datapoint->value_uint = encode_uint32(data[0], data[1], data[2], data[3]);
+        ESP_LOGD(TAG, "Datapoint %u update to %d", id, datapoint->value_int);
+        break;
+      case TuyaDatapointType::STRING:
+        datapoint->value_string.assign(reinterpret_cast<const char *>(data), data_size);
+        ESP_LOGD(TAG, "Datapoint %u update to %s", id, datapoint->value_string.c_str());
+        break;
+      case TuyaDatapointType::ENUM:
+        datapoint->value_enum = data[0];
+        ESP_LOGD(TAG, "Datapoint %u update to %d", id, datapoint->value_enum);
+        break;
+      case TuyaDatapointType::BITMASK:
+        switch (data_size) {
+          case 1:
+            datapoint->value_bitmask = encode_uint32(0, 0, 0, data[0]);
+            break;
+          case 2:
+            datapoint->value_bitmask = encode_uint32(0, 0, data[0], data[1]);
+            break;
+          default:
+            datapoint->value_bitmask = encode_uint32(data[0], data[1], data[2], data[3]);
+            break;
+        }
+        ESP_LOGD(TAG, "Datapoint %u update to %#08X", id, datapoint->value_bitmask);
+        break;
+      default:
+        break;
     }
 
     // Run through listeners
     for (auto &listener : this->listeners_) {
-      if (listener.datapoint_id == datapoint.id)
-        listener.on_datapoint(datapoint);
+      if (listener.datapoint_id == id)
+        listener.on_datapoint(*datapoint);
     }
   }
 }
 
-void Tuya::send_raw_command_(TuyaCommand command) {
-  uint8_t len_hi = (uint8_t)(command.payload.size() >> 8);
-  uint8_t len_lo = (uint8_t)(command.payload.size() & 0xFF);
+void Tuya::send_raw_command_(const TuyaCommand &command) {
+  const uint8_t *payload = command.payload();
+  uint8_t len_hi = (uint8_t)(command.payload_len >> 8);
+  uint8_t len_lo = (uint8_t)(command.payload_len & 0xFF);
   uint8_t version = 0;
 
   this->last_command_timestamp_ = millis();
@@ -356,15 +376,15 @@ void Tuya::send_raw_command_(TuyaCommand command) {
   }
 
   ESP_LOGV(TAG, "Sending Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", static_cast<uint8_t>(command.cmd),
-           version, format_hex_pretty(command.payload).c_str(), static_cast<uint8_t>(this->init_state_));
+           version, format_hex_pretty(payload, command.payload_len).c_str(), static_cast<uint8_t>(this->init_state_));
 
   this->write_array({0x55, 0xAA, version, (uint8_t) command.cmd, len_hi, len_lo});
-  if (!command.payload.empty())
-    this->write_array(command.payload.data(), command.payload.size());
+  if (command.payload_len != 0)
+    this->write_array(payload, command.payload_len);
 
   uint8_t checksum = 0x55 + 0xAA + (uint8_t) command.cmd + len_hi + len_lo;
-  for (auto &data : command.payload)
-    checksum += data;
+  for (size_t i = 0; i < command.payload_len; i++)
+    checksum += payload[i];
   this->write_byte(checksum);
 }
 
@@ -381,22 +401,39 @@ void Tuya::process_command_queue_() {
   }
 
   // Left check of delay since last command in case there's ever a command sent by calling send_raw_command_ directly
-  if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_message_.empty() &&
+  if (delay > COMMAND_DELAY && this->command_queue_count_ != 0 && this->rx_message_.empty() &&
       !this->expected_response_.has_value()) {
-    this->send_raw_command_(command_queue_.front());
-    this->command_queue_.erase(command_queue_.begin());
+    this->send_raw_command_(this->queued_command_(0));
+    this->command_queue_head_ = (this->command_queue_head_ + 1) % this->command_queue_.size();
+    this->command_queue_count_--;
   }
 }
 
-void Tuya::send_command_(const TuyaCommand &command) {
-  command_queue_.push_back(command);
-  process_command_queue_();
+TuyaCommand &Tuya::push_command_(TuyaCommandType cmd) {
+  if (this->command_queue_count_ == this->command_queue_.size()) {
+    // The MCU is slow to take commands, keep them all rather than dropping any
+    ESP_LOGD(TAG, "Command queue full, growing it to %zu commands", this->command_queue_count_ * 2);
+    std::vector<TuyaCommand> queue(this->command_queue_count_ * 2);
+    for (size_t i = 0; i < this->command_queue_count_; i++)
+      queue[i] = std::move(this->queued_command_(i));
+    this->command_queue_ = std::move(queue);
+    this->command_queue_head_ = 0;
+  }
+  TuyaCommand &command = this->queued_command_(this->command_queue_count_++);
+  command.cmd = cmd;
+  command.resize_payload(0);
+  return command;
 }
 
-void Tuya::send_empty_command_(TuyaCommandType command) {
-  send_command_(TuyaCommand{.cmd = command, .payload = std::vector<uint8_t>{}});
+void Tuya::send_command_(TuyaCommandType cmd, const uint8_t *payload, size_t len) {
+  TuyaCommand &command = this->push_command_(cmd);
+  if (len != 0)
+    memcpy(command.resize_payload(len), payload, len);
+  this->process_command_queue_();
 }
 
+void Tuya::send_empty_command_(TuyaCommandType command) { this->send_command_(command); }
+
 void Tuya::send_wifi_status_() {
   uint8_t status = 0x02;
   if (network::is_connected()) {
@@ -416,12 +453,12 @@ void Tuya::send_wifi_status_() {
 
   ESP_LOGD(TAG, "Sending WiFi Status");
   this->wifi_status_ = status;
-  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::WIFI_STATE, .payload = std::vector<uint8_t>{status}});
+  this->send_command_(TuyaCommandType::WIFI_STATE, &status, 1);
 }
 
 #ifdef USE_TIME
 void Tuya::send_local_time_() {
-  std::vector<uint8_t> payload;
+  uint8_t payload[8] = {0};
   auto *time_id = *this->time_id_;
   time::ESPTime now = time_id->now();
   if (now.is_valid()) {
@@ -437,13 +474,19 @@ void Tuya::send_local_time_() {
       day_of_week = 7;
     }
     ESP_LOGD(TAG, "Sending local time");
-    payload = std::vector<uint8_t>{0x01, year, month, day_of_month, hour, minute, second, day_of_week};
+    payload[0] = 0x01;
+    payload[1] = year;
+    payload[2] = month;
+    payload[3] = day_of_month;
+    payload[4] = hour;
+    payload[5] = minute;
+    payload[6] = second;
+    payload[7] = day_of_week;
   } else {
     // By spec we need to notify MCU that the time was not obtained if this is a response to a query
     ESP_LOGW(TAG, "Sending missing local time");
-    payload = std::vector<uint8_t>{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
   }
-  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::LOCAL_TIME_QUERY, .payload = payload});
+  this->send_command_(TuyaCommandType::LOCAL_TIME_QUERY, payload, sizeof(payload));
 }
 #endif
 
@@ -495,19 +538,19 @@ void Tuya::force_set_bitmask_datapoint_value(uint8_t datapoint_id, uint32_t valu
   this->set_numeric_datapoint_value_(datapoint_id, TuyaDatapointType::BITMASK, value, length, true);
 }
 
-optional<TuyaDatapoint> Tuya::get_datapoint_(uint8_t datapoint_id) {
+TuyaDatapoint *Tuya::get_datapoint_(uint8_t datapoint_id) {
   for (auto &datapoint : this->datapoints_) {
     if (datapoint.id == datapoint_id)
-      return datapoint;
+      return &datapoint;
   }
-  return {};
+  return nullptr;
 }
 
 void Tuya::set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, const uint32_t value,
                                         uint8_t length, bool forced) {
   ESP_LOGD(TAG, "Setting datapoint %u to %u", datapoint_id, value);
-  optional<TuyaDatapoint> datapoint = this->get_datapoint_(datapoint_id);
-  if (!datapoint.has_value()) {
+  TuyaDatapoint *datapoint = this->get_datapoint_(datapoint_id);
+  if (datapoint == nullptr) {
     ESP_LOGW(TAG, "Setting unknown datapoint %u", datapoint_id);
   } else if (datapoint->type != datapoint_type) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
@@ -517,27 +560,32 @@ void Tuya::set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType
     return;
   }
 
-  std::vector<uint8_t> data;
+  uint8_t data[4];
   switch (length) {
     case 4:
-      data.push_back(value >> 24);
-      data.push_back(value >> 16);
+      data[0] = value >> 24;
+      data[1] = value >> 16;
+      data[2] = value >> 8;
+      data[3] = value >> 0;
+      break;
     case 2:
-      data.push_back(value >> 8);
+      data[0] = value >> 8;
+      data[1] = value >> 0;
+      break;
     case 1:
-      data.push_back(value >> 0);
+      data[0] = value >> 0;
       break;
     default:
       ESP_LOGE(TAG, "Unexpected datapoint length %u", length);
       return;
   }
-  this->send_datapoint_command_(datapoint_id, datapoint_type, data);
+  this->send_datapoint_command_(datapoint_id, datapoint_type, data, length);
 }
 
 void Tuya::set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint8_t> &value, bool forced) {
   ESP_LOGD(TAG, "Setting datapoint %u to %s", datapoint_id, format_hex_pretty(value).c_str());
-  optional<TuyaDatapoint> datapoint = this->get_datapoint_(datapoint_id);
-  if (!datapoint.has_value()) {
+  TuyaDatapoint *datapoint = this->get_datapoint_(datapoint_id);
+  if (datapoint == nullptr) {
     ESP_LOGW(TAG, "Setting unknown datapoint %u", datapoint_id);
   } else if (datapoint->type != TuyaDatapointType::RAW) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
@@ -546,13 +594,13 @@ void Tuya::set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint
     ESP_LOGV(TAG, "Not sending unchanged value");
     return;
   }
-  this->send_datapoint_command_(datapoint_id, TuyaDatapointType::RAW, value);
+  this->send_datapoint_command_(datapoint_id, TuyaDatapointType::RAW, value.data(), value.size());
 }
 
 void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &value, bool forced) {
   ESP_LOGD(TAG, "Setting datapoint %u to %s", datapoint_id, value.c_str());
-  optional<TuyaDatapoint> datapoint = this->get_datapoint_(datapoint_id);
-  if (!datapoint.has_value()) {
+  TuyaDatapoint *datapoint = this->get_datapoint_(datapoint_id);
+  if (datapoint == nullptr) {
     ESP_LOGW(TAG, "Setting unknown datapoint %u", datapoint_id);
   } else if (datapoint->type != TuyaDatapointType::STRING) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
@@ -561,25 +609,39 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
     ESP_LOGV(TAG, "Not sending unchanged value");
     return;
   }
-  std::vector<uint8_t> data;
-  for (char const &c : value) {
-    data.push_back(c);
-  }
-  this->send_datapoint_command_(datapoint_id, TuyaDatapointType::STRING, data);
+  const auto *data = reinterpret_cast<const uint8_t *>(value.data());
+  this->send_datapoint_command_(datapoint_id, TuyaDatapointType::STRING, data, value.size());
 }
 
-void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data) {
-  std::vector<uint8_t> buffer;
-  buffer.push_back(datapoint_id);
-  buffer.push_back(static_cast<uint8_t>(datapoint_type));
-  buffer.push_back(data.size() >> 8);
-  buffer.push_back(data.size() >> 0);
-  buffer.insert(buffer.end(), data.begin(), data.end());
+void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, const uint8_t *data,
+                                   size_t len) {
+  // Last writer wins: a value for this datapoint that is still queued is stale now. It's removed rather than
+  // overwritten so that the order of the latest writes to different datapoints is kept.
+  for (size_t i = 0; i < this->command_queue_count_; i++) {
+    TuyaCommand &queued = this->queued_command_(i);
+    if (queued.cmd != TuyaCommandType::DATAPOINT_DELIVER || queued.payload_len == 0 ||
+        queued.payload()[0] != datapoint_id)
+      continue;
+    ESP_LOGV(TAG, "Replacing queued value of datapoint %u", datapoint_id);
+    // move the stale command to the end of the queue and drop it there
+    for (size_t j = i + 1; j < this->command_queue_count_; j++)
+      std::swap(this->queued_command_(j - 1), this->queued_command_(j));
+    this->command_queue_count_--;
+    break;
+  }
 
-  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = buffer});
+  TuyaCommand &command = this->push_command_(TuyaCommandType::DATAPOINT_DELIVER);
+  uint8_t *payload = command.resize_payload(len + 4);
+  payload[0] = datapoint_id;
+  payload[1] = static_cast<uint8_t>(datapoint_type);
+  payload[2] = len >> 8;
+  payload[3] = len >> 0;
+  if (len != 0)
+    memcpy(payload + 4, data, len);
+  this->process_command_queue_();
 }
 
-void Tuya::register_listener(uint8_t datapoint_id, const std::function<void(TuyaDatapoint)> &func) {
+void Tuya::register_listener(uint8_t datapoint_id, const std::function<void(const TuyaDatapoint &)> &func) {
   auto listener = TuyaDatapointListener{
       .datapoint_id = datapoint_id,
       .on_datapoint = func,
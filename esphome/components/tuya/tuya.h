@@ -38,7 +38,7 @@ struct TuyaDatapoint {
 
 struct TuyaDatapointListener {
   uint8_t datapoint_id;
-  std::function<void(TuyaDatapoint)> on_datapoint;
+  std::function<void(const TuyaDatapoint &)> on_datapoint;
 };
 
 enum class TuyaCommandType : uint8_t {
@@ -64,9 +64,30 @@ enum class TuyaInitState : uint8_t {
   INIT_DONE,
 };
 
+/// Number of commands that can be waiting to be sent to the MCU before the queue has to grow.
+static const size_t TUYA_COMMAND_QUEUE_SIZE = 16;
+/// Payloads up to this size are stored in the command itself, larger ones (long raw or string datapoints) on the heap.
+static const uint8_t TUYA_INLINE_PAYLOAD_SIZE = 24;
+
 struct TuyaCommand {
   TuyaCommandType cmd;
-  std::vector<uint8_t> payload;
+  uint16_t payload_len;
+  uint8_t inline_payload[TUYA_INLINE_PAYLOAD_SIZE];
+  std::vector<uint8_t> heap_payload;
+
+  /// Resize the payload to \p len bytes and return a pointer to write it to.
+  uint8_t *resize_payload(size_t len) {
+    this->payload_len = len;
+    if (len <= TUYA_INLINE_PAYLOAD_SIZE) {
+      this->heap_payload.clear();
+      return this->inline_payload;
+    }
+    this->heap_payload.resize(len);
+    return this->heap_payload.data();
+  }
+  const uint8_t *payload() const {
+    return this->payload_len <= TUYA_INLINE_PAYLOAD_SIZE ? this->inline_payload : this->heap_payload.data();
+  }
 };
 
 class Tuya : public Component, public uart::UARTDevice {
@@ -75,7 +96,7 @@ class Tuya : public Component, public uart::UARTDevice {
   void setup() override;
   void loop() override;
   void dump_config() override;
-  void register_listener(uint8_t datapoint_id, const std::function<void(TuyaDatapoint)> &func);
+  void register_listener(uint8_t datapoint_id, const std::function<void(const TuyaDatapoint &)> &func);
   void set_raw_datapoint_value(uint8_t datapoint_id, const std::vector<uint8_t> &value);
   void set_boolean_datapoint_value(uint8_t datapoint_id, bool value);
   void set_integer_datapoint_value(uint8_t datapoint_id, uint32_t value);
@@ -102,19 +123,26 @@ class Tuya : public Component, public uart::UARTDevice {
  protected:
   void handle_char_(uint8_t c);
   void handle_datapoints_(const uint8_t *buffer, size_t len);
-  optional<TuyaDatapoint> get_datapoint_(uint8_t datapoint_id);
+  TuyaDatapoint *get_datapoint_(uint8_t datapoint_id);
   bool validate_message_();
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
-  void send_raw_command_(TuyaCommand command);
+  void send_raw_command_(const TuyaCommand &command);
   void process_command_queue_();
-  void send_command_(const TuyaCommand &command);
+  /// Append a command to the queue, growing the queue if it is full.
+  TuyaCommand &push_command_(TuyaCommandType cmd);
+  /// Get the command at position \p index of the queue, 0 being the next command to send.
+  TuyaCommand &queued_command_(size_t index) {
+    return this->command_queue_[(this->command_queue_head_ + index) % this->command_queue_.size()];
+  }
+  void send_command_(TuyaCommandType cmd, const uint8_t *payload = nullptr, size_t len = 0);
   void send_empty_command_(TuyaCommandType command);
   void set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, uint32_t value,
                                     uint8_t length, bool forced);
   void set_string_datapoint_value_(uint8_t datapoint_id, const std::string &value, bool forced);
   void set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint8_t> &value, bool forced);
-  void send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data);
+  void send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, const uint8_t *data,
+                               size_t len);
   void send_wifi_status_();
 
 #ifdef USE_TIME
@@ -132,7 +160,9 @@ class Tuya : public Component, public uart::UARTDevice {
   std::vector<TuyaDatapoint> datapoints_;
   std::vector<uint8_t> rx_message_;
   std::vector<uint8_t> ignore_mcu_update_on_datapoints_{};
-  std::vector<TuyaCommand> command_queue_;
+  std::vector<TuyaCommand> command_queue_ = std::vector<TuyaCommand>(TUYA_COMMAND_QUEUE_SIZE);
+  size_t command_queue_head_ = 0;
+  size_t command_queue_count_ = 0;
   optional<TuyaCommandType> expected_response_{};
   uint8_t wifi_status_ = -1;
   CallbackManager<void()> initialized_callback_{};
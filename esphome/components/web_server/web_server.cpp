@@ -6,6 +6,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/util.h"
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 
 #include "StreamString.h"
@@ -50,29 +51,59 @@ void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &
   stream->print("</tr>");
 }
 
-UrlMatch match_url(const std::string &url, bool only_domain = false) {
-  UrlMatch match;
+struct UrlDomainEntry {
+  const char *name;
+  EntityDomain domain;
+};
+
+static const UrlDomainEntry URL_DOMAINS[] = {
+    {"sensor", ENTITY_DOMAIN_SENSOR},
+    {"switch", ENTITY_DOMAIN_SWITCH},
+    {"button", ENTITY_DOMAIN_BUTTON},
+    {"binary_sensor", ENTITY_DOMAIN_BINARY_SENSOR},
+    {"fan", ENTITY_DOMAIN_FAN},
+    {"light", ENTITY_DOMAIN_LIGHT},
+    {"text_sensor", ENTITY_DOMAIN_TEXT_SENSOR},
+    {"cover", ENTITY_DOMAIN_COVER},
+    {"number", ENTITY_DOMAIN_NUMBER},
+    {"select", ENTITY_DOMAIN_SELECT},
+    {"lock", ENTITY_DOMAIN_LOCK},
+};
+
+EntityDomain parse_url_domain(const char *str, size_t len) {
+  for (const auto &entry : URL_DOMAINS) {
+    if (strlen(entry.name) == len && memcmp(entry.name, str, len) == 0)
+      return entry.domain;
+  }
+  return ENTITY_DOMAIN_UNKNOWN;
+}
+
+UrlMatch match_url(const char *url, size_t len, bool only_domain = false) {
+  UrlMatch match{};
   match.valid = false;
-  size_t domain_end = url.find('/', 1);
-  if (domain_end == std::string::npos)
+  if (len < 1)
     return match;
-  match.domain = url.substr(1, domain_end - 1);
+  const char *end = url + len;
+  const char *domain_begin = url + 1;
+  const char *domain_end = static_cast<const char *>(memchr(domain_begin, '/', end - domain_begin));
+  if (domain_end == nullptr)
+    return match;
+  match.domain = parse_url_domain(domain_begin, domain_end - domain_begin);
   if (only_domain) {
     match.valid = true;
     return match;
   }
-  if (url.length() == domain_end - 1)
-    return match;
-  size_t id_begin = domain_end + 1;
-  size_t id_end = url.find('/', id_begin);
+  match.id = domain_end + 1;
+  const char *id_end = static_cast<const char *>(memchr(match.id, '/', end - match.id));
   match.valid = true;
-  if (id_end == std::string::npos) {
-    match.id = url.substr(id_begin, url.length() - id_begin);
+  if (id_end == nullptr) {
+    match.id_len = end - match.id;
+    match.method = end;
     return match;
   }
-  match.id = url.substr(id_begin, id_end - id_begin);
-  size_t method_begin = id_end + 1;
-  match.method = url.substr(method_begin, url.length() - method_begin);
+  match.id_len = id_end - match.id;
+  match.method = id_end + 1;
+  match.method_len = end - match.method;
   return match;
 }
 
@@ -181,6 +212,10 @@ void WebServer::dump_config() {
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
+EntityBase *WebServer::find_entity_(const UrlMatch &match) const {
+  return App.get_entity_by_object_id(match.domain, match.id, match.id_len, true);
+}
+
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
   AsyncResponseStream *stream = request->beginResponseStream("text/html");
   std::string title = App.get_name() + " Web Server";
@@ -359,24 +394,28 @@ void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
   this->events_.send(this->sensor_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<sensor::Sensor *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "sensor-" + obj->get_object_id();
-    std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-    if (!obj->get_unit_of_measurement().empty())
-      state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
-  });
+  std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+  if (!obj->get_unit_of_measurement().empty())
+    state += " " + obj->get_unit_of_measurement();
+
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "sensor-", obj->get_object_id());
+  writer.add("state", state);
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 #endif
 
@@ -385,21 +424,24 @@ void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
   this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<text_sensor::TextSensor *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->text_sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "text_sensor-", obj->get_object_id());
+  writer.add("state", value);
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 #endif
 
@@ -408,53 +450,54 @@ void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
   this->events_.send(this->switch_json(obj, state).c_str(), "state");
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "switch-", obj->get_object_id());
+  writer.add("state", value ? "ON" : "OFF");
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->defer([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<switch_::Switch *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->switch_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    this->defer([obj]() { obj->turn_on(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    this->defer([obj]() { obj->turn_off(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BUTTON
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_POST && match.method == "press") {
-      this->defer([obj]() { obj->press(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<button::Button *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_POST && match.method_equals("press")) {
+    this->defer([obj]() { obj->press(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
@@ -463,174 +506,178 @@ void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
   this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "binary_sensor-", obj->get_object_id());
+  writer.add("state", value ? "ON" : "OFF");
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<binary_sensor::BinarySensor *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->binary_sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 #endif
 
 #ifdef USE_FAN
 void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj).c_str(), "state"); }
 std::string WebServer::fan_json(fan::Fan *obj) {
-  return json::build_json([obj](JsonObject root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
-    const auto traits = obj->get_traits();
-    if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "fan-", obj->get_object_id());
+  writer.add("state", obj->state ? "ON" : "OFF");
+  writer.add("value", obj->state);
+  const auto traits = obj->get_traits();
+  if (traits.supports_speed()) {
+    writer.add("speed_level", obj->speed);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-      // NOLINTNEXTLINE(clang-diagnostic-deprecated-declarations)
-      switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
-        case fan::FAN_SPEED_LOW:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "low";
-          break;
-        case fan::FAN_SPEED_MEDIUM:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "medium";
-          break;
-        case fan::FAN_SPEED_HIGH:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "high";
-          break;
-      }
-#pragma GCC diagnostic pop
+    // NOLINTNEXTLINE(clang-diagnostic-deprecated-declarations)
+    switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
+      case fan::FAN_SPEED_LOW:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        writer.add("speed", "low");
+        break;
+      case fan::FAN_SPEED_MEDIUM:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        writer.add("speed", "medium");
+        break;
+      case fan::FAN_SPEED_HIGH:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        writer.add("speed", "high");
+        break;
     }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-  });
+#pragma GCC diagnostic pop
+  }
+  if (traits.supports_oscillation())
+    writer.add("oscillation", obj->oscillating);
+  writer.end_object();
+  return data;
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed")) {
-        String speed = request->getParam("speed")->value();
+  auto *obj = static_cast<fan::Fan *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->fan_json(obj);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    auto call = obj->turn_on();
+    if (request->hasParam("speed")) {
+      String speed = request->getParam("speed")->value();
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-        call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
+      call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
 #pragma GCC diagnostic pop
+    }
+    if (request->hasParam("speed_level")) {
+      String speed_level = request->getParam("speed_level")->value();
+      auto val = parse_number<int>(speed_level.c_str());
+      if (!val.has_value()) {
+        ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+        return;
       }
-      if (request->hasParam("speed_level")) {
-        String speed_level = request->getParam("speed_level")->value();
-        auto val = parse_number<int>(speed_level.c_str());
-        if (!val.has_value()) {
-          ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+      call.set_speed(*val);
+    }
+    if (request->hasParam("oscillation")) {
+      String speed = request->getParam("oscillation")->value();
+      auto val = parse_on_off(speed.c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          request->send(404);
           return;
-        }
-        call.set_speed(*val);
-      }
-      if (request->hasParam("oscillation")) {
-        String speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
       }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    this->defer([obj]() { obj->turn_off().perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) { this->events_.send(this->light_json(obj).c_str(), "state"); }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness"))
-        call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
-      if (request->hasParam("r"))
-        call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
-      if (request->hasParam("g"))
-        call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
-      if (request->hasParam("b"))
-        call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
-      if (request->hasParam("white_value"))
-        call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
-      if (request->hasParam("color_temp"))
-        call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
-
-      if (request->hasParam("flash")) {
-        float length_s = request->getParam("flash")->value().toFloat();
-        call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  auto *obj = static_cast<light::LightState *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-      if (request->hasParam("transition")) {
-        float length_s = request->getParam("transition")->value().toFloat();
-        call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->light_json(obj);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    auto call = obj->turn_on();
+    if (request->hasParam("brightness"))
+      call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
+    if (request->hasParam("r"))
+      call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
+    if (request->hasParam("g"))
+      call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
+    if (request->hasParam("b"))
+      call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
+    if (request->hasParam("white_value"))
+      call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
+    if (request->hasParam("color_temp"))
+      call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
+
+    if (request->hasParam("flash")) {
+      float length_s = request->getParam("flash")->value().toFloat();
+      call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
-      }
+    if (request->hasParam("transition")) {
+      float length_s = request->getParam("transition")->value().toFloat();
+      call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
-        call.set_transition_length(length);
-      }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
+    if (request->hasParam("effect")) {
+      const char *effect = request->getParam("effect")->value().c_str();
+      call.set_effect(effect);
     }
-    return;
+
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    auto call = obj->turn_off();
+    if (request->hasParam("transition")) {
+      auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
+      call.set_transition_length(length);
+    }
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj) {
   return json::build_json([obj](JsonObject root) {
@@ -644,56 +691,58 @@ std::string WebServer::light_json(light::LightState *obj) {
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) { this->events_.send(this->cover_json(obj).c_str(), "state"); }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj);
-      request->send(200, "text/json", data.c_str());
-      continue;
-    }
-
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto *obj = static_cast<cover::Cover *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->cover_json(obj);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    if (request->hasParam("position"))
-      call.set_position(request->getParam("position")->value().toFloat());
-    if (request->hasParam("tilt"))
-      call.set_tilt(request->getParam("tilt")->value().toFloat());
+  auto call = obj->make_call();
+  if (match.method_equals("open")) {
+    call.set_command_open();
+  } else if (match.method_equals("close")) {
+    call.set_command_close();
+  } else if (match.method_equals("stop")) {
+    call.set_command_stop();
+  } else if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  auto traits = obj->get_traits();
+  if ((request->hasParam("position") && !traits.get_supports_position()) ||
+      (request->hasParam("tilt") && !traits.get_supports_tilt())) {
+    request->send(409);
     return;
   }
-  request->send(404);
+
+  if (request->hasParam("position"))
+    call.set_position(request->getParam("position")->value().toFloat());
+  if (request->hasParam("tilt"))
+    call.set_tilt(request->getParam("tilt")->value().toFloat());
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "cover-", obj->get_object_id());
+  writer.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+  writer.add("value", obj->position);
+  writer.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
+
+  if (obj->get_traits().get_supports_tilt())
+    writer.add("tilt", obj->tilt);
+  writer.end_object();
+  return data;
 }
 #endif
 
@@ -702,43 +751,44 @@ void WebServer::on_number_update(number::Number *obj, float state) {
   this->events_.send(this->number_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->number_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
+  auto *obj = static_cast<number::Number *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->number_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("value")) {
-      String value = request->getParam("value")->value();
-      optional<float> value_f = parse_number<float>(value.c_str());
-      if (value_f.has_value())
-        call.set_value(*value_f);
-    }
+  auto call = obj->make_call();
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("value")) {
+    String value = request->getParam("value")->value();
+    optional<float> value_f = parse_number<float>(value.c_str());
+    if (value_f.has_value())
+      call.set_value(*value_f);
   }
-  request->send(404);
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::number_json(number::Number *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "number-" + obj->get_object_id();
-    std::string state = str_sprintf("%f", value);
-    root["state"] = state;
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "number-", obj->get_object_id());
+  writer.add("state", str_sprintf("%f", value));
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 #endif
 
@@ -747,40 +797,42 @@ void WebServer::on_select_update(select::Select *obj, const std::string &state)
   this->events_.send(this->select_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->select_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
+  auto *obj = static_cast<select::Select *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->select_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("option")) {
-      String option = request->getParam("option")->value();
-      call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
-    }
+  auto call = obj->make_call();
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("option")) {
+    String option = request->getParam("option")->value();
+    call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
   }
-  request->send(404);
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "select-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "select-", obj->get_object_id());
+  writer.add("state", value);
+  writer.add("value", value);
+  writer.end_object();
+  return data;
 }
 #endif
 
@@ -789,35 +841,37 @@ void WebServer::on_lock_update(lock::Lock *obj) {
   this->events_.send(this->lock_json(obj, obj->state).c_str(), "state");
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "lock-" + obj->get_object_id();
-    root["state"] = lock::lock_state_to_string(value);
-    root["value"] = value;
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("id", "lock-", obj->get_object_id());
+  writer.add("state", lock::lock_state_to_string(value));
+  writer.add("value", static_cast<int>(value));
+  writer.end_object();
+  return data;
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->lock_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "lock") {
-      this->defer([obj]() { obj->lock(); });
-      request->send(200);
-    } else if (match.method == "unlock") {
-      this->defer([obj]() { obj->unlock(); });
-      request->send(200);
-    } else if (match.method == "open") {
-      this->defer([obj]() { obj->open(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<lock::Lock *>(this->find_entity_(match));
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->lock_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("lock")) {
+    this->defer([obj]() { obj->lock(); });
+    request->send(200);
+  } else if (match.method_equals("unlock")) {
+    this->defer([obj]() { obj->unlock(); });
+    request->send(200);
+  } else if (match.method_equals("open")) {
+    this->defer([obj]() { obj->open(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
@@ -835,61 +889,61 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
     return true;
 #endif
 
-  UrlMatch match = match_url(request->url().c_str(), true);
+  UrlMatch match = match_url(request->url().c_str(), request->url().length(), true);
   if (!match.valid)
     return false;
 #ifdef USE_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "sensor")
+  if (request->method() == HTTP_GET && match.domain == ENTITY_DOMAIN_SENSOR)
     return true;
 #endif
 
 #ifdef USE_SWITCH
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "switch")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_SWITCH)
     return true;
 #endif
 
 #ifdef USE_BUTTON
-  if (request->method() == HTTP_POST && match.domain == "button")
+  if (request->method() == HTTP_POST && match.domain == ENTITY_DOMAIN_BUTTON)
     return true;
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "binary_sensor")
+  if (request->method() == HTTP_GET && match.domain == ENTITY_DOMAIN_BINARY_SENSOR)
     return true;
 #endif
 
 #ifdef USE_FAN
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "fan")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_FAN)
     return true;
 #endif
 
 #ifdef USE_LIGHT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "light")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_LIGHT)
     return true;
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "text_sensor")
+  if (request->method() == HTTP_GET && match.domain == ENTITY_DOMAIN_TEXT_SENSOR)
     return true;
 #endif
 
 #ifdef USE_COVER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "cover")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_COVER)
     return true;
 #endif
 
 #ifdef USE_NUMBER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "number")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_NUMBER)
     return true;
 #endif
 
 #ifdef USE_SELECT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "select")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_SELECT)
     return true;
 #endif
 
 #ifdef USE_LOCK
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "lock")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == ENTITY_DOMAIN_LOCK)
     return true;
 #endif
 
@@ -915,79 +969,79 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
-  UrlMatch match = match_url(request->url().c_str());
+  UrlMatch match = match_url(request->url().c_str(), request->url().length());
 #ifdef USE_SENSOR
-  if (match.domain == "sensor") {
+  if (match.domain == ENTITY_DOMAIN_SENSOR) {
     this->handle_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_SWITCH
-  if (match.domain == "switch") {
+  if (match.domain == ENTITY_DOMAIN_SWITCH) {
     this->handle_switch_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_BUTTON
-  if (match.domain == "button") {
+  if (match.domain == ENTITY_DOMAIN_BUTTON) {
     this->handle_button_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  if (match.domain == "binary_sensor") {
+  if (match.domain == ENTITY_DOMAIN_BINARY_SENSOR) {
     this->handle_binary_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_FAN
-  if (match.domain == "fan") {
+  if (match.domain == ENTITY_DOMAIN_FAN) {
     this->handle_fan_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_LIGHT
-  if (match.domain == "light") {
+  if (match.domain == ENTITY_DOMAIN_LIGHT) {
     this->handle_light_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  if (match.domain == "text_sensor") {
+  if (match.domain == ENTITY_DOMAIN_TEXT_SENSOR) {
     this->handle_text_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_COVER
-  if (match.domain == "cover") {
+  if (match.domain == ENTITY_DOMAIN_COVER) {
     this->handle_cover_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_NUMBER
-  if (match.domain == "number") {
+  if (match.domain == ENTITY_DOMAIN_NUMBER) {
     this->handle_number_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_SELECT
-  if (match.domain == "select") {
+  if (match.domain == ENTITY_DOMAIN_SELECT) {
     this->handle_select_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_LOCK
-  if (match.domain == "lock") {
+  if (match.domain == ENTITY_DOMAIN_LOCK) {
     this->handle_lock_request(request, match);
     return;
   }
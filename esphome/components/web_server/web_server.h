@@ -4,19 +4,31 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/components/web_server_base/web_server_base.h"
 
+#include <cstring>
 #include <vector>
 
 namespace esphome {
 namespace web_server {
 
-/// Internal helper struct that is used to parse incoming URLs
+/** Internal helper struct that is used to parse incoming URLs.
+ *
+ * The id and method point into the parsed URL, so a match is only valid as long as the URL is.
+ */
 struct UrlMatch {
-  std::string domain;  ///< The domain of the component, for example "sensor"
-  std::string id;      ///< The id of the device that's being accessed, for example "living_room_fan"
-  std::string method;  ///< The method that's being called, for example "turn_on"
-  bool valid;          ///< Whether this match is valid
+  EntityDomain domain;  ///< The domain of the component, for example ENTITY_DOMAIN_SENSOR for "sensor"
+  const char *id;       ///< The id of the device that's being accessed, for example "living_room_fan"
+  size_t id_len;        ///< The length of the id
+  const char *method;   ///< The method that's being called, for example "turn_on"
+  size_t method_len;    ///< The length of the method
+  bool valid;           ///< Whether this match is valid
+
+  /// Check whether the method of this match is equal to \p str.
+  bool method_equals(const char *str) const {
+    return strlen(str) == this->method_len && memcmp(str, this->method, this->method_len) == 0;
+  }
 };
 
 /** This class allows users to create a web server with their ESP nodes.
@@ -203,6 +215,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// Find the entity addressed by \p match, or nullptr if there's no such entity.
+  EntityBase *find_entity_(const UrlMatch &match) const;
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   const char *css_url_{nullptr};
@@ -243,6 +243,7 @@ def _validate(config):
 
 
 CONF_OUTPUT_POWER = "output_power"
+CONF_REUSE_DHCP_LEASE = "reuse_dhcp_lease"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -261,6 +262,7 @@ CONFIG_SCHEMA = cv.All(
                 CONF_POWER_SAVE_MODE, esp8266="none", esp32="light"
             ): cv.enum(WIFI_POWER_SAVE_MODES, upper=True),
             cv.Optional(CONF_FAST_CONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_REUSE_DHCP_LEASE, default=False): cv.boolean,
             cv.Optional(CONF_USE_ADDRESS): cv.string_strict,
             cv.SplitDefault(CONF_OUTPUT_POWER, esp8266=20.0): cv.All(
                 cv.decibel, cv.float_range(min=10.0, max=20.5)
@@ -358,6 +360,8 @@ async def to_code(config):
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_power_save_mode(config[CONF_POWER_SAVE_MODE]))
     cg.add(var.set_fast_connect(config[CONF_FAST_CONNECT]))
+    if config[CONF_REUSE_DHCP_LEASE]:
+        cg.add(var.set_reuse_dhcp_lease(True))
     if CONF_OUTPUT_POWER in config:
         cg.add(var.set_output_power(config[CONF_OUTPUT_POWER]))
 
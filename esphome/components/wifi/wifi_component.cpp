@@ -9,6 +9,8 @@
 
 #include <utility>
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include "lwip/err.h"
 #include "lwip/dns.h"
 
@@ -40,6 +42,7 @@ void WiFiComponent::setup() {
 
   uint32_t hash = fnv1_hash(App.get_compilation_time());
   this->pref_ = global_preferences->make_preference<wifi::SavedWifiSettings>(hash, true);
+  this->network_pref_ = global_preferences->make_preference<wifi::SavedWifiNetwork>(hash + 1, true);
 
   SavedWifiSettings save{};
   if (this->pref_.load(&save)) {
@@ -61,7 +64,9 @@ void WiFiComponent::setup() {
       ESP_LOGV(TAG, "Setting Power Save Option failed!");
     }
 
-    if (this->fast_connect_) {
+    if (this->connect_saved_network_()) {
+      // skip the scan, if this fails we fall back to scanning
+    } else if (this->fast_connect_) {
       this->selected_ap_ = this->sta_[0];
       this->start_connecting(this->selected_ap_, false);
     } else {
@@ -368,6 +373,83 @@ void WiFiComponent::print_connect_params_() {
   ESP_LOGCONFIG(TAG, "  DNS2: %s", wifi_dns_ip_(1).str().c_str());
 }
 
+bool WiFiComponent::connect_saved_network_() {
+  if (!this->network_pref_.load(&this->saved_network_))
+    return false;
+
+  for (auto &config : this->sta_) {
+    if (fnv1_hash(config.get_ssid()) != this->saved_network_.ssid_hash)
+      continue;
+
+    WiFiAP connect_params;
+    connect_params.set_ssid(config.get_ssid());
+    connect_params.set_hidden(config.get_hidden());
+    connect_params.set_password(config.get_password());
+#ifdef USE_WIFI_WPA2_EAP
+    connect_params.set_eap(config.get_eap());
+#endif
+    bssid_t bssid;
+    std::copy(std::begin(this->saved_network_.bssid), std::end(this->saved_network_.bssid), bssid.begin());
+    connect_params.set_bssid(bssid);
+    connect_params.set_channel(this->saved_network_.channel);
+    connect_params.set_manual_ip(config.get_manual_ip());
+    if (this->reuse_dhcp_lease_ && !config.get_manual_ip().has_value() && this->saved_network_.ip != 0) {
+      // Reusing the last lease skips DHCP, which is most of the connection time
+      ManualIP lease{};
+      lease.static_ip = this->saved_network_.ip;
+      lease.gateway = this->saved_network_.gateway;
+      lease.subnet = this->saved_network_.subnet;
+      lease.dns1 = this->saved_network_.dns1;
+      lease.dns2 = this->saved_network_.dns2;
+      connect_params.set_manual_ip(lease);
+      this->using_saved_lease_ = true;
+    }
+
+    ESP_LOGD(TAG, "Connecting to the network of the last connection on channel %u", this->saved_network_.channel);
+    this->connecting_saved_network_ = true;
+    this->selected_ap_ = connect_params;
+    this->start_connecting(connect_params, false);
+    return true;
+  }
+  return false;
+}
+
+void WiFiComponent::save_network_() {
+  SavedWifiNetwork network{};
+  network.ssid_hash = fnv1_hash(wifi_ssid());
+  bssid_t bssid = wifi_bssid();
+  std::copy(bssid.begin(), bssid.end(), std::begin(network.bssid));
+  network.channel = static_cast<uint8_t>(wifi_channel_());
+  // The lease is only saved to be reused, and it only belongs to the access point it came from
+  bool same_ap = memcmp(network.bssid, this->saved_network_.bssid, sizeof(network.bssid)) == 0;
+  if (this->reuse_dhcp_lease_ && (!this->using_saved_lease_ || same_ap)) {
+    network.ip = wifi_sta_ip();
+    network.gateway = wifi_gateway_ip_();
+    network.subnet = wifi_subnet_mask_();
+    network.dns1 = wifi_dns_ip_(0);
+    network.dns2 = wifi_dns_ip_(1);
+  }
+  // Only write when something changed, most connections are to the same network
+  if (memcmp(&network, &this->saved_network_, sizeof(network)) == 0)
+    return;
+  this->saved_network_ = network;
+  this->network_pref_.save(&network);
+}
+
+void WiFiComponent::drop_saved_lease_() {
+  this->using_saved_lease_ = false;
+  this->selected_ap_.set_manual_ip({});
+  if (this->saved_network_.ip == 0)
+    return;
+  ESP_LOGD(TAG, "Forgetting the saved DHCP lease");
+  this->saved_network_.ip = 0;
+  this->saved_network_.gateway = 0;
+  this->saved_network_.subnet = 0;
+  this->saved_network_.dns1 = 0;
+  this->saved_network_.dns2 = 0;
+  this->network_pref_.save(&this->saved_network_);
+}
+
 void WiFiComponent::start_scanning() {
   this->action_started_ = millis();
   ESP_LOGD(TAG, "Starting scan...");
@@ -520,6 +602,8 @@ void WiFiComponent::check_connecting_finished() {
     }
 #endif
 
+    this->save_network_();
+    this->connecting_saved_network_ = false;
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTED;
     this->num_retried_ = 0;
     return;
@@ -576,6 +660,16 @@ void WiFiComponent::retry_connect() {
     this->num_retried_++;
   }
   this->error_from_callback_ = false;
+  // The saved lease might not be valid anymore, connect with DHCP from now on
+  if (this->using_saved_lease_)
+    this->drop_saved_lease_();
+  if (this->connecting_saved_network_) {
+    // The network might have moved to another access point or channel
+    ESP_LOGD(TAG, "Connecting to the network of the last connection failed, scanning...");
+    this->connecting_saved_network_ = false;
+    this->start_scanning();
+    return;
+  }
   if (this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTING) {
     yield();
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING_2;
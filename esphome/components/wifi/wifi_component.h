@@ -32,6 +32,19 @@ struct SavedWifiSettings {
   char password[65];
 } PACKED;  // NOLINT
 
+/// The network of the last successful connection, to connect to it without a scan after a reboot.
+struct SavedWifiNetwork {
+  uint32_t ssid_hash;
+  uint8_t bssid[6];
+  uint8_t channel;
+  // The last DHCP lease, only reused with reuse_dhcp_lease
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+} PACKED;  // NOLINT
+
 enum WiFiComponentState {
   /** Nothing has been initialized yet. Internal AP, if configured, is disabled at this point. */
   WIFI_COMPONENT_STATE_OFF = 0,
@@ -187,6 +200,7 @@ class WiFiComponent : public Component {
   void check_scanning_finished();
   void start_connecting(const WiFiAP &ap, bool two);
   void set_fast_connect(bool fast_connect);
+  void set_reuse_dhcp_lease(bool reuse_dhcp_lease) { this->reuse_dhcp_lease_ = reuse_dhcp_lease; }
   void set_ap_timeout(uint32_t ap_timeout) { ap_timeout_ = ap_timeout; }
 
   void check_connecting_finished();
@@ -263,6 +277,12 @@ class WiFiComponent : public Component {
   static std::string format_mac_addr(const uint8_t mac[6]);
   void setup_ap_config_();
   void print_connect_params_();
+  /// Connect directly to the network of the last successful connection, returns false if there's none.
+  bool connect_saved_network_();
+  /// Remember the network we just connected to.
+  void save_network_();
+  /// Forget the saved DHCP lease and use DHCP again for the next connection.
+  void drop_saved_lease_();
 
   void wifi_loop_();
   bool wifi_mode_(optional<bool> sta, optional<bool> ap);
@@ -326,6 +346,13 @@ class WiFiComponent : public Component {
   optional<float> output_power_;
   ESPPreferenceObject pref_;
   bool has_saved_wifi_settings_{false};
+  ESPPreferenceObject network_pref_;
+  SavedWifiNetwork saved_network_{};
+  /// Whether the current connection attempt is to the saved network, a failure falls back to scanning.
+  bool connecting_saved_network_{false};
+  bool reuse_dhcp_lease_{false};
+  /// Whether the selected network uses the saved DHCP lease as its static IP.
+  bool using_saved_lease_{false};
 };
 
 extern WiFiComponent *global_wifi_component;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
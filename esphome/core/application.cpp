@@ -3,6 +3,8 @@
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
 
+#include <cstring>
+
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
@@ -27,6 +29,7 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  this->build_entity_index_();
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -63,6 +66,84 @@ void Application::setup() {
   this->schedule_dump_config();
   this->calculate_looping_components_();
 }
+void Application::build_entity_index_() {
+  this->entity_index_.clear();
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : this->binary_sensors_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_BINARY_SENSOR, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : this->switches_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_SWITCH, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_BUTTON
+  for (auto *obj : this->buttons_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_BUTTON, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_SENSOR
+  for (auto *obj : this->sensors_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_SENSOR, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : this->text_sensors_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_TEXT_SENSOR, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_FAN
+  for (auto *obj : this->fans_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_FAN, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_COVER
+  for (auto *obj : this->covers_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_COVER, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_CLIMATE
+  for (auto *obj : this->climates_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_CLIMATE, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : this->lights_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_LIGHT, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_NUMBER
+  for (auto *obj : this->numbers_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_NUMBER, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_SELECT
+  for (auto *obj : this->selects_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_SELECT, obj->get_object_id_hash(), obj});
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : this->locks_)
+    this->entity_index_.push_back({ENTITY_DOMAIN_LOCK, obj->get_object_id_hash(), obj});
+#endif
+  this->entity_index_.shrink_to_fit();
+  // Stable sort, so that entities with colliding hashes are still found in registration order.
+  std::stable_sort(this->entity_index_.begin(), this->entity_index_.end());
+}
+EntityBase *Application::get_entity_by_key(EntityDomain domain, uint32_t key, bool include_internal) {
+  EntityIndexEntry needle{domain, key, nullptr};
+  auto it = std::lower_bound(this->entity_index_.begin(), this->entity_index_.end(), needle);
+  for (; it != this->entity_index_.end() && it->domain == domain && it->key == key; it++) {
+    if (include_internal || !it->entity->is_internal())
+      return it->entity;
+  }
+  return nullptr;
+}
+EntityBase *Application::get_entity_by_object_id(EntityDomain domain, const char *object_id, size_t len,
+                                                 bool include_internal) {
+  EntityIndexEntry needle{domain, fnv1_hash(object_id, len), nullptr};
+  auto it = std::lower_bound(this->entity_index_.begin(), this->entity_index_.end(), needle);
+  // Walk all entities with this hash, another object id may hash to the same key.
+  for (; it != this->entity_index_.end() && it->domain == domain && it->key == needle.key; it++) {
+    if (!include_internal && it->entity->is_internal())
+      continue;
+    const std::string &id = it->entity->get_object_id();
+    if (id.size() == len && memcmp(id.data(), object_id, len) == 0)
+      return it->entity;
+  }
+  return nullptr;
+}
+
 void Application::loop() {
   uint32_t new_app_state = 0;
 
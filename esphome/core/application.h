@@ -5,9 +5,11 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/scheduler.h"
+#include "esphome/core/update_planner.h"
 
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
@@ -168,117 +170,107 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<binary_sensor::BinarySensor *>(
+        this->get_entity_by_key(ENTITY_DOMAIN_BINARY_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<switch_::Switch *>(this->get_entity_by_key(ENTITY_DOMAIN_SWITCH, key, include_internal));
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<button::Button *>(this->get_entity_by_key(ENTITY_DOMAIN_BUTTON, key, include_internal));
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<sensor::Sensor *>(this->get_entity_by_key(ENTITY_DOMAIN_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<text_sensor::TextSensor *>(
+        this->get_entity_by_key(ENTITY_DOMAIN_TEXT_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<fan::Fan *>(this->get_entity_by_key(ENTITY_DOMAIN_FAN, key, include_internal));
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<cover::Cover *>(this->get_entity_by_key(ENTITY_DOMAIN_COVER, key, include_internal));
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<light::LightState *>(this->get_entity_by_key(ENTITY_DOMAIN_LIGHT, key, include_internal));
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<climate::Climate *>(this->get_entity_by_key(ENTITY_DOMAIN_CLIMATE, key, include_internal));
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<number::Number *>(this->get_entity_by_key(ENTITY_DOMAIN_NUMBER, key, include_internal));
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<select::Select *>(this->get_entity_by_key(ENTITY_DOMAIN_SELECT, key, include_internal));
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<lock::Lock *>(this->get_entity_by_key(ENTITY_DOMAIN_LOCK, key, include_internal));
   }
 #endif
 
+  /** Find the entity of \p domain whose object id hash is \p key.
+   *
+   * This uses an index sorted by domain and key that is built in setup(), so it only finds entities that were
+   * registered before that.
+   */
+  EntityBase *get_entity_by_key(EntityDomain domain, uint32_t key, bool include_internal = false);
+  /// Find the entity of \p domain with the object id \p object_id of \p len characters, even if its hash collides.
+  EntityBase *get_entity_by_object_id(EntityDomain domain, const char *object_id, size_t len,
+                                      bool include_internal = false);
+
   Scheduler scheduler;
+  UpdatePlanner update_planner;
 
  protected:
   friend Component;
 
+  /// Entry of the entity index, ordered by domain and object id hash.
+  struct EntityIndexEntry {
+    EntityDomain domain;
+    uint32_t key;
+    EntityBase *entity;
+
+    bool operator<(const EntityIndexEntry &other) const {
+      return this->domain < other.domain || (this->domain == other.domain && this->key < other.key);
+    }
+  };
+
+  void build_entity_index_();
+
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
@@ -287,6 +279,7 @@ class Application {
 
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
+  std::vector<EntityIndexEntry> entity_index_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/preferences.h"
 
 namespace esphome {
@@ -134,6 +136,8 @@ template<typename... Ts> class Action {
   }
   /// Check if this or any of the following actions are currently running.
   virtual bool is_running() { return this->num_running_ > 0 || this->is_running_next_(); }
+  /// Preallocate the state for this many runs of this action waiting at the same time, if it has any.
+  virtual void reserve_runs(size_t runs) {}
 
   /// The total number of actions that are currently running in this plus any of
   /// the following actions in the chain.
@@ -208,6 +212,10 @@ template<typename... Ts> class ActionList {
       this->actions_begin_->stop_complex();
   }
   bool empty() const { return this->actions_begin_ == nullptr; }
+  void reserve_runs(size_t runs) {
+    for (Action<Ts...> *action = this->actions_begin_; action != nullptr; action = action->next_)
+      action->reserve_runs(runs);
+  }
 
   /// Check if any action in this action list is currently running.
   bool is_running() {
@@ -245,9 +253,95 @@ template<typename... Ts> class Automation {
   /// Return the number of actions in the action part of this automation that are currently running.
   int num_running() { return this->actions_.num_running(); }
 
+  /// Preallocate the state of delays and waits for this many runs of this automation at the same time.
+  void reserve_runs(size_t runs) { this->actions_.reserve_runs(runs); }
+
  protected:
   Trigger<Ts...> *trigger_;
   ActionList<Ts...> actions_;
 };
 
+/** The runs of an action that continue later, like delays and waits.
+ *
+ * Each waiting run is kept in a slot with a copy of its arguments, instead of in a closure for the scheduler. Slots
+ * are reused once their run continues, so this only allocates when more runs wait at the same time than ever before.
+ */
+template<typename... Ts> class ActionRuns {
+ public:
+  struct Run {
+    std::tuple<typename std::decay<Ts>::type...> args;
+    uint32_t start;
+    uint32_t timeout;
+    bool active;
+  };
+
+  /// Preallocate slots for this many runs waiting at the same time.
+  void reserve(size_t runs) { this->runs_.reserve(runs); }
+
+  /// Store a run that continues later, \p timeout is in milliseconds from now.
+  void add(uint32_t timeout, Ts... x) {
+    Run *run = nullptr;
+    for (auto &slot : this->runs_) {
+      if (!slot.active) {
+        run = &slot;
+        break;
+      }
+    }
+    if (run == nullptr) {
+      this->runs_.emplace_back();
+      run = &this->runs_.back();
+    }
+    run->args = std::make_tuple(x...);
+    run->start = millis();
+    run->timeout = timeout;
+    run->active = true;
+    this->num_active_++;
+  }
+
+  /** Continue the runs for which \p done returns true, by passing their arguments to \p next.
+   *
+   * \p done is called with the run and its arguments, \p next only with the arguments.
+   */
+  template<typename D, typename N> void resume(D &&done, N &&next) {
+    // By index, next may add runs and move the slots
+    for (size_t i = 0; i < this->runs_.size() && this->num_active_ != 0; i++) {
+      if (!this->runs_[i].active || !this->check_(done, this->runs_[i], typename gens<sizeof...(Ts)>::type()))
+        continue;
+      this->runs_[i].active = false;
+      this->num_active_--;
+      auto args = std::move(this->runs_[i].args);
+      this->apply_(next, args, typename gens<sizeof...(Ts)>::type());
+    }
+  }
+
+  bool empty() const { return this->num_active_ == 0; }
+
+  /// Milliseconds from \p now until the first run times out, 0 if one did already. Only call this if not empty().
+  uint32_t next_timeout_in(uint32_t now) const {
+    uint32_t wait = UINT32_MAX;
+    for (const auto &run : this->runs_) {
+      if (!run.active)
+        continue;
+      uint32_t elapsed = now - run.start;
+      wait = std::min(wait, elapsed >= run.timeout ? 0 : run.timeout - elapsed);
+    }
+    return wait;
+  }
+
+  void clear() {
+    for (auto &run : this->runs_)
+      run.active = false;
+    this->num_active_ = 0;
+  }
+
+ protected:
+  template<typename F, int... S> bool check_(F &f, const Run &run, seq<S...>) {
+    return f(run, std::get<S>(run.args)...);
+  }
+  template<typename F, typename A, int... S> void apply_(F &f, A &args, seq<S...>) { f(std::get<S>(args)...); }
+
+  std::vector<Run> runs_;
+  size_t num_active_{0};
+};
+
 }  // namespace esphome
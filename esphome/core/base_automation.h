@@ -109,16 +109,48 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    this->runs_.add(this->delay_.value(x...), x...);
+    this->schedule_();
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    this->runs_.clear();
+    this->cancel_timeout("delay");
+    this->scheduled_ = false;
+  }
+  void reserve_runs(size_t runs) override { this->runs_.reserve(runs); }
+
+ protected:
+  /// Set one timeout for the run that is due first, unless the one that is set already is early enough.
+  void schedule_() {
+    if (this->runs_.empty())
+      return;
+    const uint32_t now = millis();
+    const uint32_t wait = this->runs_.next_timeout_in(now);
+    const uint32_t due = now + wait;
+    if (this->scheduled_ && static_cast<int32_t>(due - this->scheduled_due_) >= 0)
+      return;
+    this->scheduled_ = true;
+    this->scheduled_due_ = due;
+    this->set_timeout("delay", wait, [this]() {
+      this->scheduled_ = false;
+      const uint32_t fired = millis();
+      this->runs_.resume(
+          [fired](const typename ActionRuns<Ts...>::Run &run, Ts... x) { return fired - run.start >= run.timeout; },
+          [this](Ts... x) { this->play_next_(x...); });
+      this->schedule_();
+    });
+  }
+
+  ActionRuns<Ts...> runs_;
+  /// Whether a timeout is set, and when it runs.
+  bool scheduled_{false};
+  uint32_t scheduled_due_{0};
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -171,6 +203,11 @@ template<typename... Ts> class IfAction : public Action<Ts...> {
     this->else_.stop();
   }
 
+  void reserve_runs(size_t runs) override {
+    this->then_.reserve_runs(runs);
+    this->else_.reserve_runs(runs);
+  }
+
  protected:
   Condition<Ts...> *condition_;
   ActionList<Ts...> then_;
@@ -217,6 +254,7 @@ template<typename... Ts> class WhileAction : public Action<Ts...> {
   }
 
   void stop() override { this->then_.stop(); }
+  void reserve_runs(size_t runs) override { this->then_.reserve_runs(runs); }
 
  protected:
   Condition<Ts...> *condition_;
@@ -250,6 +288,7 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
   }
 
   void stop() override { this->then_.stop(); }
+  void reserve_runs(size_t runs) override { this->then_.reserve_runs(runs); }
 
  protected:
   uint32_t iteration_;
@@ -272,27 +311,20 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       }
       return;
     }
-    this->var_ = std::make_tuple(x...);
-
-    if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
-    }
-
-    this->loop();
+    this->runs_.add(this->timeout_value_.value(x...), x...);
   }
 
+  // Conditions don't report when they change, so the waiting runs check theirs every loop
   void loop() override {
-    if (this->num_running_ == 0)
-      return;
-
-    if (!this->condition_->check_tuple(this->var_)) {
+    if (this->runs_.empty())
       return;
-    }
-
-    this->cancel_timeout("timeout");
-
-    this->play_next_tuple_(this->var_);
+    const uint32_t now = millis();
+    const bool has_timeout = this->timeout_value_.has_value();
+    this->runs_.resume(
+        [this, now, has_timeout](const typename ActionRuns<Ts...>::Run &run, Ts... x) {
+          return this->condition_->check(x...) || (has_timeout && now - run.start >= run.timeout);
+        },
+        [this](Ts... x) { this->play_next_(x...); });
   }
 
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -300,11 +332,12 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout("timeout"); }
+  void stop() override { this->runs_.clear(); }
+  void reserve_runs(size_t runs) override { this->runs_.reserve(runs); }
 
  protected:
   Condition<Ts...> *condition_;
-  std::tuple<Ts...> var_{};
+  ActionRuns<Ts...> runs_;
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
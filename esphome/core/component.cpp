@@ -183,8 +183,8 @@ void PollingComponent::call_setup() {
   // Let the polling component subclass setup their HW.
   this->setup();
 
-  // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  // Register interval, at a phase that keeps it apart from the other updates.
+  App.update_planner.add(this);
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
@@ -49,6 +49,12 @@ static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
     ESP_LOGCONFIG(TAG, "  Update Interval: %.3fs", this->get_update_interval() / 1000.0f); \
   } else { \
     ESP_LOGCONFIG(TAG, "  Update Interval: %.1fs", this->get_update_interval() / 1000.0f); \
+  } \
+  if (this->get_update_cost() != 0) { \
+    ESP_LOGCONFIG(TAG, "  Update Phase: %.3fs, takes %.1fms", this->get_update_phase() / 1000.0f, \
+                  this->get_update_cost() / 1000.0f); \
+  } else if (this->get_update_phase() != 0) { \
+    ESP_LOGCONFIG(TAG, "  Update Phase: %.3fs", this->get_update_phase() / 1000.0f); \
   }
 
 extern const uint32_t COMPONENT_STATE_MASK;
@@ -292,8 +298,25 @@ class PollingComponent : public Component {
   /// Get the update interval in ms of this sensor
   virtual uint32_t get_update_interval() const;
 
+  /** Set the group of this component for planning its updates, for example the bus it uses.
+   *
+   * The UpdatePlanner keeps the updates of components in the same group apart.
+   */
+  void set_update_group(const void *group) { this->update_group_ = group; }
+  /// Get the phase of the updates in ms, the value of millis() modulo the update interval when they run.
+  uint32_t get_update_phase() const { return this->update_phase_; }
+  /// Get how long update() takes in µs on average, 0 if that wasn't measured (yet).
+  uint32_t get_update_cost() const { return this->update_cost_us_; }
+
  protected:
+  friend class UpdatePlanner;
+
   uint32_t update_interval_;
+  const void *update_group_{nullptr};
+  uint32_t update_phase_{0};
+  uint32_t update_cost_us_{0};
+  uint8_t update_runs_{0};
+  bool update_phase_changed_{false};
 };
 
 class WarnIfComponentBlockingGuard {
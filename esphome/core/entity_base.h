@@ -11,6 +11,23 @@ enum EntityCategory : uint8_t {
   ENTITY_CATEGORY_DIAGNOSTIC = 2,
 };
 
+/// The domains that entities can belong to, used together with the object id hash to look up entities.
+enum EntityDomain : uint8_t {
+  ENTITY_DOMAIN_UNKNOWN = 0,
+  ENTITY_DOMAIN_BINARY_SENSOR,
+  ENTITY_DOMAIN_SWITCH,
+  ENTITY_DOMAIN_BUTTON,
+  ENTITY_DOMAIN_SENSOR,
+  ENTITY_DOMAIN_TEXT_SENSOR,
+  ENTITY_DOMAIN_FAN,
+  ENTITY_DOMAIN_COVER,
+  ENTITY_DOMAIN_CLIMATE,
+  ENTITY_DOMAIN_LIGHT,
+  ENTITY_DOMAIN_NUMBER,
+  ENTITY_DOMAIN_SELECT,
+  ENTITY_DOMAIN_LOCK,
+};
+
 // The generic Entity base class that provides an interface common to all Entities.
 class EntityBase {
  public:
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -151,6 +153,8 @@ uint8_t crc8(uint8_t *data, uint8_t len);
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of the \p len characters at \p str.
+uint32_t fnv1_hash(const char *str, size_t len);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
@@ -437,16 +441,102 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 /// @name Utilities
 /// @{
 
+template<typename... X> class InlineCallback;
+
+/** A callable like std::function, that keeps small functors in the object itself instead of on the heap.
+ *
+ * Functors of up to four pointers in size fit inline, which covers lambdas capturing `this` and a few more pointers
+ * as well as a std::function. Larger functors are still allocated.
+ *
+ * @tparam Ts The arguments for the callback, wrapped in void().
+ */
+template<typename... Ts> class InlineCallback<void(Ts...)> {
+ public:
+  InlineCallback() = default;
+  template<typename F, enable_if_t<!std::is_same<typename std::decay<F>::type, InlineCallback>::value, int> = 0>
+  InlineCallback(F &&callback) {  // NOLINT(google-explicit-constructor)
+    this->assign_<typename std::decay<F>::type>(std::forward<F>(callback));
+  }
+  InlineCallback(InlineCallback &&other) noexcept { this->move_from_(other); }
+  InlineCallback &operator=(InlineCallback &&other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->move_from_(other);
+    }
+    return *this;
+  }
+  InlineCallback(const InlineCallback &) = delete;
+  InlineCallback &operator=(const InlineCallback &) = delete;
+  ~InlineCallback() { this->reset(); }
+
+  void operator()(Ts... args) { this->invoke_(&this->storage_, args...); }
+  explicit operator bool() const { return this->invoke_ != nullptr; }
+
+  void reset() {
+    if (this->manage_ != nullptr)
+      this->manage_(&this->storage_, nullptr);
+    this->invoke_ = nullptr;
+    this->manage_ = nullptr;
+  }
+
+ protected:
+  using Storage = typename std::aligned_storage<4 * sizeof(void *), alignof(std::max_align_t)>::type;
+  template<typename F>
+  using FitsInline = std::integral_constant<bool, sizeof(F) <= sizeof(Storage) && alignof(F) <= alignof(Storage) &&
+                                                      std::is_nothrow_move_constructible<F>::value>;
+
+  template<typename F, typename A> void assign_(A &&callback) {
+    this->assign_<F>(std::forward<A>(callback), FitsInline<F>());
+  }
+  template<typename F, typename A> void assign_(A &&callback, std::true_type) {
+    new (&this->storage_) F(std::forward<A>(callback));
+    this->invoke_ = [](Storage *storage, Ts... args) { (*reinterpret_cast<F *>(storage))(args...); };
+    // Without a destination the callback is destroyed, otherwise it's moved there
+    this->manage_ = [](Storage *storage, Storage *dest) {
+      F *callback = reinterpret_cast<F *>(storage);
+      if (dest != nullptr)
+        new (dest) F(std::move(*callback));
+      callback->~F();
+    };
+  }
+  template<typename F, typename A> void assign_(A &&callback, std::false_type) {
+    new (&this->storage_) F *(new F(std::forward<A>(callback)));  // NOLINT(cppcoreguidelines-owning-memory)
+    this->invoke_ = [](Storage *storage, Ts... args) { (**reinterpret_cast<F **>(storage))(args...); };
+    this->manage_ = [](Storage *storage, Storage *dest) {
+      F **callback = reinterpret_cast<F **>(storage);
+      if (dest != nullptr) {
+        new (dest) F *(*callback);
+      } else {
+        delete *callback;  // NOLINT(cppcoreguidelines-owning-memory)
+      }
+    };
+  }
+  void move_from_(InlineCallback &other) {
+    if (other.manage_ != nullptr)
+      other.manage_(&other.storage_, &this->storage_);
+    this->invoke_ = other.invoke_;
+    this->manage_ = other.manage_;
+    other.invoke_ = nullptr;
+    other.manage_ = nullptr;
+  }
+
+  Storage storage_;
+  void (*invoke_)(Storage *storage, Ts... args){nullptr};
+  void (*manage_)(Storage *storage, Storage *dest){nullptr};
+};
+
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
+ *
+ * The callbacks are stored next to each other, small ones without any further allocation.
  *
  * @tparam Ts The arguments for the callbacks, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
   /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  template<typename F> void add(F &&callback) { this->callbacks_.emplace_back(std::forward<F>(callback)); }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
@@ -458,7 +548,7 @@ template<typename... Ts> class CallbackManager<void(Ts...)> {
   void operator()(Ts... args) { call(args...); }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  std::vector<InlineCallback<void(Ts...)>> callbacks_;
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -9,6 +9,8 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Items that are done and kept to be reused
+static const size_t MAX_POOLED_ITEMS = 8;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -25,7 +27,7 @@ void HOT Scheduler::set_timeout(Component *component, const std::string &name, u
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
   item->type = SchedulerItem::TIMEOUT;
@@ -41,6 +43,30 @@ bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> &&func) {
+  // only put offset in lower half
+  uint32_t offset = 0;
+  if (interval != 0)
+    offset = (random_uint32() % interval) / 2;
+
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  this->set_interval_(component, name, interval, offset + interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval, uint32_t phase,
+                                 std::function<void()> &&func) {
+  uint32_t elapsed = interval;
+  if (interval != 0 && interval != SCHEDULER_DONT_RUN) {
+    // time until millis() % interval reaches the phase again, a whole interval if it is there now
+    uint32_t position = this->millis_() % interval;
+    phase %= interval;
+    uint32_t wait = phase > position ? phase - position : interval - (position - phase);
+    elapsed = interval - wait;
+  }
+
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, phase=%u)", name.c_str(), interval, phase);
+  this->set_interval_(component, name, interval, elapsed, std::move(func));
+}
+void HOT Scheduler::set_interval_(Component *component, const std::string &name, uint32_t interval, uint32_t elapsed,
+                                  std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
   if (!name.empty())
@@ -49,19 +75,12 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval == SCHEDULER_DONT_RUN)
     return;
 
-  // only put offset in lower half
-  uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
-
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
-
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
-  item->last_execution = now - offset - interval;
+  item->last_execution = now - elapsed;
   item->last_execution_major = this->millis_major_;
   if (item->last_execution > now)
     item->last_execution_major--;
@@ -87,7 +106,7 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)", name.c_str(),
             initial_wait_time, max_attempts, backoff_increase_factor);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
   item->type = SchedulerItem::RETRY;
@@ -210,6 +229,7 @@ void IRAM_ATTR HOT Scheduler::call() {
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->release_item_(std::move(item));
         continue;
       }
 
@@ -225,6 +245,8 @@ void IRAM_ATTR HOT Scheduler::call() {
             item->interval *= item->backoff_multiplier;
         }
         this->push_(std::move(item));
+      } else {
+        this->release_item_(std::move(item));
       }
     }
   }
@@ -234,6 +256,7 @@ void IRAM_ATTR HOT Scheduler::call() {
 void HOT Scheduler::process_to_add() {
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->release_item_(std::move(it));
       continue;
     }
 
@@ -254,9 +277,27 @@ void HOT Scheduler::cleanup_() {
 }
 void HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  // The caller may have moved the item out already
+  if (this->items_.back())
+    this->release_item_(std::move(this->items_.back()));
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  if (this->item_pool_.empty())
+    return make_unique<SchedulerItem>();
+  auto item = std::move(this->item_pool_.back());
+  this->item_pool_.pop_back();
+  return item;
+}
+void HOT Scheduler::release_item_(std::unique_ptr<SchedulerItem> item) {
+  if (this->item_pool_.size() >= MAX_POOLED_ITEMS)
+    return;
+  // Release what the callbacks captured now rather than when the item is reused
+  item->void_callback = nullptr;
+  item->retry_callback = nullptr;
+  this->item_pool_.push_back(std::move(item));
+}
 bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
   bool ret = false;
   for (auto &it : this->items_) {
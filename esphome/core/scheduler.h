@@ -13,6 +13,12 @@ class Scheduler {
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
   bool cancel_timeout(Component *component, const std::string &name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
+  /** Like set_interval(), but run at a fixed \p phase: whenever millis() modulo \p interval reaches it.
+   *
+   * Unlike set_interval() the first run isn't right away, but the next time the phase is reached.
+   */
+  void set_interval(Component *component, const std::string &name, uint32_t interval, uint32_t phase,
+                    std::function<void()> &&func);
   bool cancel_interval(Component *component, const std::string &name);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
@@ -26,6 +32,10 @@ class Scheduler {
   void process_to_add();
 
  protected:
+  /// Add an interval that last ran \p elapsed ms ago.
+  void set_interval_(Component *component, const std::string &name, uint32_t interval, uint32_t elapsed,
+                     std::function<void()> &&func);
+
   struct SchedulerItem {
     Component *component;
     std::string name;
@@ -74,6 +84,10 @@ class Scheduler {
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
+  /// Get an item to fill in, one that was released before if there is any.
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  /// Keep an item that is done to be reused, so rescheduling doesn't allocate every time.
+  void release_item_(std::unique_ptr<SchedulerItem> item);
   bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
@@ -82,6 +96,7 @@ class Scheduler {
 
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
@@ -0,0 +1,148 @@
+#include "update_planner.h"
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+
+namespace esphome {
+
+static const char *const TAG = "update_planner";
+
+// Updates closer than this may end up in the same loop iteration
+static const uint32_t COLLISION_WINDOW_MS = 20;
+// Candidate phases tried per interval
+static const uint32_t MAX_CANDIDATES = 128;
+// Cost assumed for updates that didn't run yet
+static const uint32_t DEFAULT_COST_US = 1000;
+// Colliding with an update of the same group counts this many times its cost
+static const uint32_t SAME_GROUP_FACTOR = 4;
+// Updates measured before the phases are planned again
+static const uint8_t MEASURE_RUNS = 3;
+// Plan again after this long even if some updates didn't run often enough, like ones with a long interval
+static const uint32_t MAX_MEASURE_TIME_MS = 60000;
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+static bool is_planned(const PollingComponent *component) {
+  uint32_t interval = component->get_update_interval();
+  return interval != SCHEDULER_DONT_RUN && interval >= COLLISION_WINDOW_MS;
+}
+
+void UpdatePlanner::add(PollingComponent *component) {
+  if (!is_planned(component)) {
+    // Updates that never run or run in (nearly) every iteration have no phase worth planning
+    App.scheduler.set_interval(component, "update", component->get_update_interval(),
+                               [component]() { component->update(); });
+    return;
+  }
+  if (this->components_.empty()) {
+    App.scheduler.set_timeout(nullptr, "update_planner", MAX_MEASURE_TIME_MS, [this]() {
+      if (!this->replanned_)
+        this->replan_();
+    });
+  }
+  this->components_.push_back(component);
+  this->plan_(component, this->components_.size() - 1);
+  this->start_(component);
+  // The first update runs right after setup, the phase only applies to the ones after it
+  App.scheduler.set_timeout(component, "", 0, [this, component]() { this->run_(component); });
+}
+
+uint32_t UpdatePlanner::load_at_(PollingComponent *component, uint32_t phase, size_t before) const {
+  uint32_t interval = component->get_update_interval();
+  uint32_t load = 0;
+  for (size_t i = 0; i < before; i++) {
+    const PollingComponent *other = this->components_[i];
+    uint32_t other_interval = other->get_update_interval();
+    // The distance between any two updates is a multiple of the gcd of both intervals away from the phase difference
+    uint32_t step = gcd(interval, other_interval);
+    uint32_t difference = (phase % step + step - other->update_phase_ % step) % step;
+    if (std::min(difference, step - difference) >= COLLISION_WINDOW_MS)
+      continue;
+    // They meet once every other_interval / step updates of the other component
+    uint32_t cost = other->update_cost_us_ != 0 ? other->update_cost_us_ : DEFAULT_COST_US;
+    uint64_t weight = uint64_t(cost) * step / other_interval;
+    if (other->update_group_ != nullptr && other->update_group_ == component->update_group_)
+      weight *= SAME_GROUP_FACTOR;
+    load += weight;
+  }
+  return load;
+}
+
+void UpdatePlanner::plan_(PollingComponent *component, size_t before) {
+  uint32_t interval = component->get_update_interval();
+  uint32_t spacing = std::max(COLLISION_WINDOW_MS, interval / MAX_CANDIDATES);
+  uint32_t best_phase = 0;
+  uint32_t best_load = UINT32_MAX;
+  for (uint32_t phase = 0; phase < interval; phase += spacing) {
+    uint32_t load = this->load_at_(component, phase, before);
+    if (load < best_load) {
+      best_load = load;
+      best_phase = phase;
+      if (load == 0)
+        break;
+    }
+  }
+  component->update_phase_ = best_phase;
+}
+
+void UpdatePlanner::start_(PollingComponent *component) {
+  App.scheduler.set_interval(component, "update", component->get_update_interval(), component->update_phase_,
+                             [this, component]() { this->run_(component); });
+}
+
+void UpdatePlanner::run_(PollingComponent *component) {
+  uint32_t start = micros();
+  component->update();
+  uint32_t cost = std::max<uint32_t>(micros() - start, 1);
+
+  if (component->update_runs_ == 0) {
+    component->update_cost_us_ = cost;
+  } else {
+    component->update_cost_us_ = (component->update_cost_us_ * 3 + cost) / 4;
+  }
+  if (component->update_runs_ < MEASURE_RUNS)
+    component->update_runs_++;
+  if (!this->replanned_ && this->all_measured_())
+    this->replan_();
+  // Move to a new phase only after the update that was already scheduled, so it isn't delayed
+  if (component->update_phase_changed_) {
+    component->update_phase_changed_ = false;
+    this->start_(component);
+  }
+}
+
+bool UpdatePlanner::all_measured_() {
+  // Failed components don't update any more, they would hold off planning forever
+  for (auto *component : this->components_) {
+    if (component->update_runs_ < MEASURE_RUNS && !component->is_failed())
+      return false;
+  }
+  return true;
+}
+
+void UpdatePlanner::replan_() {
+  this->replanned_ = true;
+  std::stable_sort(this->components_.begin(), this->components_.end(),
+                   [](const PollingComponent *a, const PollingComponent *b) {
+                     return a->update_cost_us_ > b->update_cost_us_;
+                   });
+  for (size_t i = 0; i < this->components_.size(); i++) {
+    PollingComponent *component = this->components_[i];
+    uint32_t phase = component->update_phase_;
+    this->plan_(component, i);
+    if (component->update_phase_ != phase)
+      component->update_phase_changed_ = true;
+  }
+  ESP_LOGD(TAG, "Planned the updates of %zu components with their measured costs", this->components_.size());
+}
+
+}  // namespace esphome
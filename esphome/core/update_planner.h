@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+
+class PollingComponent;
+
+/** Spreads the updates of polling components over their update intervals.
+ *
+ * Every component updates at a fixed phase, the time within its interval (millis() modulo the interval) with the
+ * least load from the updates planned before it. Updates collide when they may run in the same loop iteration, each
+ * collision weighs the cost of the other update by how often they meet. Updates of components in the same group, like
+ * the devices on one bus, weigh more, so those keep apart as well.
+ *
+ * The cost of an update isn't known at first. Once the updates of all components that didn't fail ran a few times, or
+ * after a minute at the latest, the phases are planned once more with the measured costs, the most expensive updates
+ * first. A component moves to its new phase after the update that was
+ * already scheduled, so no update is pushed back.
+ *
+ * The first update of each component runs right after its setup, the phase only applies to the updates after it.
+ */
+class UpdatePlanner {
+ public:
+  /// Plan the updates of \p component and start them.
+  void add(PollingComponent *component);
+
+ protected:
+  /// Choose the phase of \p component against the components before it in components_.
+  void plan_(PollingComponent *component, size_t before);
+  /// Load \p component would meet at \p phase, from the first \p before components.
+  uint32_t load_at_(PollingComponent *component, uint32_t phase, size_t before) const;
+  void start_(PollingComponent *component);
+  void run_(PollingComponent *component);
+  /// Whether every component that didn't fail updated often enough to know its cost.
+  bool all_measured_();
+  void replan_();
+
+  std::vector<PollingComponent *> components_;
+  bool replanned_{false};
+};
+
+}  // namespace esphome
@@ -0,0 +1,101 @@
+"""Tests for the run-length encoding of display bitmaps and images"""
+
+from hypothesis import given
+from hypothesis import strategies as st
+
+from esphome.components.display import rle_encode_bits, rle_encode_pixels
+
+
+def decode_bits(data, count):
+    """Decode like decode_rle_bits() in display_buffer.cpp"""
+    bits = []
+    for byte in data:
+        bits += [False] * (byte >> 4) + [True] * (byte & 0x0F)
+    assert len(bits) >= count
+    return bits[:count]
+
+
+def decode_pixels(data, count, size):
+    """Decode like decode_rle_pixels() in display_buffer.cpp"""
+    pixels = []
+    pos = 0
+    while pos < len(data):
+        run = data[pos]
+        pixels += [tuple(data[pos + 1 : pos + 1 + size])] * run
+        pos += 1 + size
+    assert len(pixels) == count
+    return pixels
+
+
+def test_rle_encode_bits_runs():
+    """
+    Each byte should hold a run of unset pixels followed by a run of set pixels
+    """
+    # Given
+    bits = [False] * 3 + [True] * 2 + [False] + [True] * 5
+
+    # When
+    data = rle_encode_bits(bits)
+
+    # Then
+    assert data == [0x32, 0x15]
+
+
+def test_rle_encode_bits_splits_long_runs():
+    """
+    Runs longer than 15 pixels should be split over several bytes
+    """
+    # Given
+    bits = [False] * 20 + [True] * 17
+
+    # When
+    data = rle_encode_bits(bits)
+
+    # Then
+    assert data == [0xF0, 0x5F, 0x02]
+    assert decode_bits(data, len(bits)) == bits
+
+
+def test_rle_encode_pixels_splits_long_runs():
+    """
+    Runs longer than 255 pixels should be split
+    """
+    # Given
+    pixels = [(1, 2, 3)] * 300
+
+    # When
+    data = rle_encode_pixels(pixels)
+
+    # Then
+    assert data == [255, 1, 2, 3, 45, 1, 2, 3]
+
+
+@given(st.lists(st.booleans(), max_size=500))
+def test_rle_encode_bits_round_trip(bits):
+    assert decode_bits(rle_encode_bits(bits), len(bits)) == bits
+
+
+@given(
+    st.lists(
+        st.sampled_from([(0,), (1,), (128,), (255,)]).flatmap(
+            lambda pixel: st.lists(st.just(pixel), min_size=1, max_size=300)
+        ),
+        max_size=10,
+    )
+)
+def test_rle_encode_grayscale_round_trip(runs):
+    pixels = [pixel for run in runs for pixel in run]
+    assert decode_pixels(rle_encode_pixels(pixels), len(pixels), 1) == pixels
+
+
+@given(
+    st.lists(
+        st.tuples(
+            st.integers(0, 255), st.integers(0, 255), st.integers(0, 255)
+        ).flatmap(lambda pixel: st.lists(st.just(pixel), min_size=1, max_size=300)),
+        max_size=10,
+    )
+)
+def test_rle_encode_rgb24_round_trip(runs):
+    pixels = [pixel for run in runs for pixel in run]
+    assert decode_pixels(rle_encode_pixels(pixels), len(pixels), 3) == pixels